@@ -10,6 +10,40 @@
 #include <unistd.h>                         // used to import sleep() function
 #include <chrono>                           // benchmark function
 #include <cstdint>                          // benchmark function
+#include <cstring>                          // memcpy float bits for radix keys
+#include <iterator>                         // iterator_traits for value types
+#include <memory>                           // scratch buffers for out of place sorts
+#include <string>                           // parse command line flags
+#include <type_traits>                      // pick radix key type per value type
+#include <thread>                           // parallel sorts
+#include <atomic>                           // hand out work to threads
+#include <limits>                           // padding values for sorting networks
+#include <cstdio>                           // large block file reads and writes for external sort
+#include <cctype>                           // parse text keys
+#include <charconv>                         // write text keys
+#include <fcntl.h>                          // tell the kernel external sort reads files front to back
+#include <cmath>                            // floyd-rivest sample window
+#include <tuple>                            // hold one row of several columns while permuting
+#include <numeric>                          // identity permutation for the permute benchmark
+#include <functional>                       // comparators and projections
+#include <array>                            // burstsort trie nodes
+#include <string_view>                      // byte prefixes of string keys
+#if defined(__SSE2__)
+#include <emmintrin.h>                      // non-temporal stores
+#endif
+
+// gcc vector extensions let one sorting network compile to AVX2, SSE or plain code, and target_clones picks the best
+// one the cpu supports when the program starts. other compilers get the scalar fallback
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_NETWORKS
+#define SIMD_CLONES __attribute__((target_clones("avx2", "sse4.1", "default")))
+#endif
+
+// hand written AVX2 / AVX-512 kernels, chosen at run time with __builtin_cpu_supports
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>                      // vectorized partition
+#define SIMD_PARTITION
+#endif
 
 
 /* OPENGL FUNCTIONS FOR SET-UP AND DRAWING */
@@ -40,44 +74,523 @@ void setup_buffers(unsigned int &VBO, unsigned int &EBO, unsigned int &VAO);
 /// @brief draw each of the numbers in the array, moving to the right each time, scaling height with value
 /// @param vec a vector holding all the numers involved
 /// @param shader shader object to draw with
+/// @param window window to draw to, nullptr to skip drawing (used to benchmark without graphics)
 template <class RandomIt>
 void draw_array(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
 
+/// @brief the height of the bar drawn for value, so the sorts also compile for things that aren't numbers
+/// @return value as a float, or 0 if it can't be converted to one
+template <class T>
+float bar_value(const T& value);
+
 /// @brief change the perspective and vector for a new size - some algorithms take too long on big arrays
 /// @param new_size  - the number of elements to put in the array, will be modifed
 /// @param shader - shader to change the mat4 for perspective
 /// @return the new vector of nums 1 - size
 std::vector<int> change_size(const int new_size, Shader* shader);
 
+/// @brief projection that hands back its argument unchanged, the default for sorts that take one (std::identity before C++20)
+struct identity_projection {
+    template <class T>
+    constexpr T&& operator()(T&& value) const noexcept {return std::forward<T>(value);}
+};
+
+/// @brief compare two elements by comp on their projections, the way std::ranges sorts do. comp and proj can be
+/// anything std::invoke takes, so proj can be a pointer to a member. with std::less<> and identity_projection it is a < b
+template <class Compare, class Projection, class A, class B>
+inline bool projected_less(Compare& comp, Projection& proj, const A& a, const B& b);
+
+/// @brief whether comp and proj just mean a < b for values of type T, so a sort can use kernels that only know that order
+template <class Compare, class Projection, class T>
+constexpr bool is_natural_order = std::is_same_v<Projection, identity_projection>
+    && (std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>);
+
+
+/// @brief whether It walks one flat array, so &*first can be used as a pointer to all of it: pointers and vector
+/// iterators. C++17 has no contiguous iterator concept, so anything else (a deque) counts as not flat
+template <class It, class T = typename std::iterator_traits<It>::value_type>
+constexpr bool is_contiguous_iterator = std::is_pointer_v<It> || (!std::is_same_v<T, bool>
+    && (std::is_same_v<It, typename std::vector<T>::iterator> || std::is_same_v<It, typename std::vector<T>::const_iterator>));
+
+/// @brief sort a copy of [first, last) in a vector with sort, then copy it back, for kernels that need flat storage
+template <class RandomIt, class Sort>
+void sort_flat_copy(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, const Sort& sort);
+
 
 /* SORTING ALGORITHMS - EACH SHOULD ONLY TAKE FIRST AND LAST ITERATORS TO SORT  (plus opengl shader to draw) */
 /// @brief sort a vector or other data type that can be traversed with iterators
 /// from least to biggest, assuming they are full of numbers
 /// at each step, if graphics are enabled, then when a number is overwritten it will be displayed
 /// std::is_sorted() will return true after each one
+/// the ones taking comp and proj (bubble, shaker, selection, insertion and quicksort) order by comp(proj(a), proj(b))
+/// instead, like std::ranges::sort. the defaults compile to the same compares as a plain <
 
 // traverse list, comparing adjacent items and moving the larger one towards the end
-template <class RandomIt>
-void bubble_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+template <class RandomIt, class Compare = std::less<>, class Projection = identity_projection>
+void bubble_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp = {}, Projection proj = {});
 
 // similar to bubble, but when the end is reached traverse backwards and move the smaller items to the beginning
+template <class RandomIt, class Compare = std::less<>, class Projection = identity_projection>
+void shaker_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp = {}, Projection proj = {});
+
+// bubble sort comparing items a gap apart instead of neighbours, so small items near the end move forward quickly.
+// the gap shrinks by 1.3 each pass (jumping from 9 or 10 to 11, which leaves fewer items out of place), then stays at 1
+// until a pass swaps nothing
+template <class RandomIt>
+void comb_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// comb sort that goes back down the array with the same gap after every pass up it, like shaker sort
+template <class RandomIt>
+void bidirectional_comb_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// bubble sort where every compare of a pass is independent: compare all the (even, odd) neighbour pairs, then all the
+// (odd, even) pairs, until a round of both swaps nothing. each pass is split across every core and done a vector of
+// pairs at a time with odd_even_exchange. O(n^2) like bubble, a baseline for how far parallelism takes it.
+// draws after every pass, with one thread when graphics are enabled. anything but a pointer or vector is sorted in a copy
 template <class RandomIt>
-void shaker_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+void odd_even_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
 
 // search the list and find the smallest element, swap it to the beginning of the unsorted portion, and update the sorted portion to include it
+template <class RandomIt, class Compare = std::less<>, class Projection = identity_projection>
+void selection_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp = {}, Projection proj = {});
+
+// fewest writes possible: take the first element, count the smaller ones to find where it belongs, drop it there and
+// pick up what was there, and follow the cycle until something lands back at the start. every element is written once,
+// straight into its final place, and ones already in place not at all. O(n^2) compares. for memory that pays per write
 template <class RandomIt>
-void selection_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+void cycle_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
 
 // sorted and unsorted portion of the array. 
 // insert the first unsorted num into the sorted portion, shuffling numbers as needed - poor performance on arrays due to insert heavy algorithm
+template <class RandomIt, class Compare = std::less<>, class Projection = identity_projection>
+void insertion_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp = {}, Projection proj = {});
+
+// insertion sort that finds each element's spot with a branchless binary search and shifts the sorted elements after
+// it in one move_backward (which the standard library turns into a memmove for trivially copyable types in contiguous
+// storage) instead of one at a time. stable, draws once per insert. the small array leaf of the hybrid sorts
 template <class RandomIt>
-void insertion_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+void binary_insertion_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
 
 
 // due to recursive implementation, the starting first and last pointers need to be kept track of for drawing. last 4 arguments can be
 // removed from every call for a regular sorting array
-template <typename RandomIt>
-void quicksort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, RandomIt OG_first, RandomIt OG_last);
+template <typename RandomIt, class Compare = std::less<>, class Projection = identity_projection>
+void quicksort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, RandomIt OG_first, RandomIt OG_last,
+               Compare comp = {}, Projection proj = {});
+
+// put the element that belongs at nth there, with nothing bigger before it and nothing smaller after it, without sorting
+// the rest (introselect). partitions like quicksort but only follows the side holding nth. big ranges pick their pivot
+// Floyd-Rivest style, by first selecting nth inside a small window around it, so the pivot lands close to nth and the
+// range shrinks fast. falls back to heap_select if the partitions keep coming out lopsided. draws after every partition
+template <class RandomIt>
+void select_nth(RandomIt first, RandomIt nth, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// sort only the smallest middle - first elements into [first, middle), the rest is left in no particular order.
+// select_nth splits them off, then a quicksort that skips the part after any pivot landing past middle sorts them, with
+// median of three pivots and the same heap_select fall back as select_nth
+template <class RandomIt>
+void partial_quicksort(RandomIt first, RandomIt middle, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// partial sort with a bounded heap: [first, middle) is a max heap of the smallest elements seen so far, every later
+// element smaller than its top replaces it. O(n log k), best when k is small. draws after every replacement
+template <class RandomIt, class Compare = std::less<>, class Projection = identity_projection>
+void heap_select(RandomIt first, RandomIt middle, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp = {}, Projection proj = {});
+
+/// @brief the k smallest values of a stream in one pass, keeping only a k element max heap, like heap_select
+/// @param first start of the values, read once
+/// @param last end of the values
+/// @param k how many to keep
+/// @return the smallest min(k, count) values, sorted
+template <class InputIt>
+std::vector<typename std::iterator_traits<InputIt>::value_type> smallest_k(InputIt first, InputIt last, std::size_t k);
+
+// sort up to 64 elements at once with a bitonic sorting network, comparing a whole vector of keys per instruction.
+// int32, float and int64 in contiguous storage use the vectorized network, anything else falls back to binary insertion sort.
+// the block is drawn once it is sorted
+template <class RandomIt>
+void network_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// split the array into 64 element blocks, sort each with network_sort, then kway_merge the blocks together.
+// stable for types without a sorting network. streaming_stores is passed on to kway_merge. with a comp other than
+// std::less the blocks are insertion sorted instead, so any comparator gives a stable sort
+template <class RandomIt, class Compare = std::less<>>
+void merge_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, bool streaming_stores = false,
+                Compare comp = {});
+
+// find the runs already in the array (reversing strictly descending ones, and topping up runs shorter than 64 with
+// network_sort) and kway_merge them. close to linear on arrays that are mostly in order
+template <class RandomIt>
+void natural_merge_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// stable merge sort without a heap allocation. sorts 32 element blocks with network_sort, then merges neighbouring runs in place:
+// a run that fits in a fixed 512 element buffer on the stack is merged through it (raw storage, so nothing is constructed
+// until it is used, and it's reserved once rather than in every level of the recursion), longer ones are split by rotating
+// the middle of the longer run past its place in the other run, leaving two smaller independent merges
+template <class RandomIt>
+void inplace_merge_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// merge the sorted runs [first + bounds[i], first + bounds[i + 1]) into one sorted array. neighbouring runs are merged in
+// pairs through a scratch buffer until one is left. int32, float and int64 go through simd_merge, other types are merged
+// one element at a time, taking from the left run on ties so it is stable. bounds starts at 0 and ends at last - first,
+// and the runs are in order by comp. only std::less uses simd_merge or streaming, other comparators merge an element at a time.
+// with streaming_stores each merge goes through a 4 KB staging buffer that is written out a cache line at a time with
+// non-temporal stores, like parallel_radix_sort. ignored outside vectors and pointers, and for types that aren't
+// trivial or whose size doesn't divide 64
+template <class RandomIt, class Compare = std::less<>>
+void kway_merge(RandomIt first, RandomIt last, std::vector<std::size_t> bounds, const Shader* shader, GLFWwindow* window,
+                bool streaming_stores = false, Compare comp = {});
+
+// bitonic sort, the same compares in the same order whatever the input, so its run time only depends on the size.
+// pads the array to a power of two with copies of the largest element, sorts 64 element blocks with sorting networks,
+// then merges them with compare steps that are split across every core. each block is finished with bitonic_clean
+template <class RandomIt>
+void bitonic_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// parallel sample sort. picks 255 splitters from a sorted random sample, then every thread sorts the elements of its
+// slice into the 256 buckets between them by walking a branchless binary tree of splitters. the buckets are scattered
+// through a scratch buffer like parallel_radix_sort, then the threads take buckets off a shared counter and sort them.
+// when the sample repeats a splitter, the duplicates are dropped and every splitter gets an equality bucket next to its
+// bucket for the elements equal to it, which needs no sorting (like IPS4o), so few distinct keys still spread over the
+// threads instead of piling into one bucket. for arithmetic types. anything but a vector or pointer range is sorted in a copy
+template <class RandomIt>
+void sample_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// quicksort on ints that partitions a whole vector of keys at a time with simd_partition, pivot is the median of the
+// first, middle and last elements. falls back to heap sort if the partitions keep coming out lopsided, and finishes
+// partitions of 64 or fewer with network_sort. other types use quicksort, and ints outside a vector or pointer range
+// are sorted in a copy. drawn after every partition
+template <class RandomIt>
+void simd_quicksort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// not comparison based. count every digit of every key in one pass, then scatter the array by each digit from least to most
+// significant into a scratch buffer and back. works on 8/16/32/64 bit integers and floats, skips digits that every key shares
+template <class RandomIt>
+void radix_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// in place radix sort starting from the most significant digit (american flag sort). count the digits, swap every element
+// straight into its bucket, then recurse into each bucket with the next digit. small buckets are finished with network_sort.
+// needs no scratch array, unlike radix_sort
+template <class RandomIt>
+void msd_radix_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// radix_sort split across every core. each thread counts the digits in its slice of the array, works out where its
+// slice's keys go, and scatters them through small per bucket buffers so each write to the output is a whole cache line.
+// worker threads cannot draw, so the array is drawn once after each pass.
+// with streaming_stores the full lines are written with non-temporal stores, skipping the read the cache would do before
+// overwriting them. only in contiguous storage (vectors and pointers), ignored anywhere else
+template <class RandomIt>
+void parallel_radix_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, bool streaming_stores = false);
+
+// count how many times each value shows up, then write every value back in order that many times. O(n + k) for keys in
+// a range of k values, so only worth it when k is not much bigger than n: wider ranges are radix sorted instead.
+// integers only. finds the smallest and largest value itself, or takes them as min_key and max_key (every key must be inside them)
+template <class RandomIt>
+void counting_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+template <class RandomIt, class T>
+void counting_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, T min_key, T max_key);
+
+// stable counting sort of keys that also moves each key's value, from values_first onwards, to the same position
+template <class KeyIt, class ValueIt>
+void counting_sort_by_key(KeyIt keys_first, KeyIt keys_last, ValueIt values_first, const Shader* shader, GLFWwindow* window);
+
+/// @brief whether n keys from min_key to max_key are few enough values apart for counting sort's counters, at most 4 per
+/// element. the range is worked out in 64 bits, so the full range of int64_t doesn't wrap around to a small one
+template <class T>
+bool counting_range_fits(T min_key, T max_key, std::size_t n);
+
+// sort integers with counting_sort when their range is no bigger than their count, radix_sort otherwise
+template <class RandomIt>
+void integer_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// the string sorts take std::string or anything else with size() and [] giving chars, and sort bytewise like std::string's <.
+// they look at each string one byte at a time instead of comparing whole strings, so the bytes two strings share are not
+// read again on every compare. bars can't show strings, so drawing only shows the array being moved around
+
+// three way radix quicksort (Bentley-Sedgewick). partitions on the byte at the current depth around a median of three
+// pivot byte into less, equal and greater, then sorts less and greater at the same depth and the equal part one byte deeper
+template <class RandomIt>
+void multikey_quicksort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// msd radix sort for strings. each pass first copies the byte at the current depth of every string into a small
+// contiguous cache, then counts and scatters from the cache, so every string is read once per pass instead of twice.
+// a byte that every string shares (a common prefix, like a scheme or a date) is skipped without moving anything.
+// buckets of fewer than 32 strings are finished with multikey_quicksort
+template <class RandomIt>
+void msd_string_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// burstsort. inserts the indices of the strings into a trie of buckets, one trie level per byte, and bursts a bucket into a
+// new trie node once it holds more than 8192, so each bucket stays small enough to sort in cache. then walks the trie in
+// order, sorts every bucket with multikey_quicksort from the depth it sits at, and moves the strings into that order
+template <class RandomIt>
+void burstsort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window);
+
+// the order that sorts the array by key_of(element), without moving anything: element order[i] belongs at i.
+// sorts compact (key, index) pairs instead of the elements. keys of up to 32 bits are packed into one 64 bit integer
+// with the index below them and radix sorted, other keys are merge sorted. stable. key_of defaults to the element itself
+template <class RandomIt>
+std::vector<std::size_t> argsort(RandomIt first, RandomIt last);
+
+template <class RandomIt, class KeyFunc>
+std::vector<std::size_t> argsort(RandomIt first, RandomIt last, KeyFunc key_of);
+
+// move element order[i] to position i for every i, each element moved once. follows each cycle of the permutation from
+// its first position, marking positions done in a bit per element. draws after every move
+template <class RandomIt, class IndexIt>
+void apply_permutation(RandomIt first, RandomIt last, IndexIt order, const Shader* shader, GLFWwindow* window);
+
+// apply_permutation to several parallel arrays (columns of the same rows) at once, in one walk over the cycles.
+// the only extra memory is a bit per row. nothing is drawn
+template <class IndexIt, class... RandomIts>
+void permute_columns(IndexIt order, std::size_t n, RandomIts... columns);
+
+// permute_columns split across every core. about one row in 1024 is a break, picked by hashing its position, and each
+// thread takes the breaks in its block of rows and walks each one's cycle up to the next break, so the long cycles of a
+// random permutation are shared out too. the value at each break is set aside first and dropped into the right hole at
+// the end. cycles without a break are moved by whichever thread owns their smallest row. takes a byte per row
+template <class IndexIt, class... RandomIts>
+void parallel_permute_columns(IndexIt order, std::size_t n, RandomIts... columns);
+
+// stable sort for big elements: argsort by key_of(element), then apply_permutation, so every element is moved once
+// instead of log n times
+template <class RandomIt, class KeyFunc>
+void sort_by_key(RandomIt first, RandomIt last, KeyFunc key_of, const Shader* shader, GLFWwindow* window);
+
+// sort by comp(proj(a), proj(b)), picking the kernel from the types: sort_by(first, last, shader, window, std::greater<>())
+// sorts descending, sort_by(first, last, shader, window, {}, &Point::x) by a field. integers and floats compared with
+// std::less or std::greater go to integer_sort or radix_sort and are reversed for descending. numbers projected out of
+// a bigger element go through sort_by_key, with their radix_key bits flipped for descending, so sorting by a field is
+// stable. other types in their natural order are merge sorted, and anything else is merge sorted with comp, so every
+// order sort_by gives is stable
+template <class RandomIt, class Compare = std::less<>, class Projection = identity_projection>
+void sort_by(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp = {}, Projection proj = {});
+
+// what decorated_sort did instead of comparing. a comparison sort that works the key out inside its comparator needs at
+// least comparison_bound = log2(n!) compares in the worst case, and computes two keys for each
+struct DecorateStats {
+    std::size_t size = 0;
+    std::size_t key_calls = 0;          // key_of calls, one per element
+    std::size_t compared = 0;           // elements whose prefixes never told them apart, sorted with comp
+    uint64_t full_compares = 0;         // comp calls on those elements' keys
+    uint64_t comparison_bound = 0;
+
+    /// @brief how many of the bound's compares were never made
+    uint64_t saved() const {return comparison_bound > full_compares ? comparison_bound - full_compares : 0;}
+};
+
+/// @brief one line of stats for the log
+std::ostream& operator<<(std::ostream& out, const DecorateStats& stats);
+
+// decorate, sort, undecorate, for keys that cost something to work out (parsing, normalizing, hashing): sorts by
+// comp(key_of(a), key_of(b)) calling key_of once per element. with std::less or std::greater every key also gets a 64 bit
+// prefix that orders the same way: radix_key for numbers, which is the whole key, and for strings 8 bytes after the bytes
+// all the keys share. the prefixes are argsorted, and a run of equal string prefixes gets a new prefix from after the
+// bytes that run shares until it stops splitting. only then, or for other keys and comparators, does comp decide.
+// stable, and the elements are moved once by apply_permutation
+template <class RandomIt, class KeyFunc, class Compare = std::less<>>
+DecorateStats decorated_sort(RandomIt first, RandomIt last, KeyFunc key_of, const Shader* shader, GLFWwindow* window, Compare comp = {});
+
+// what smart_sort found out about its input, and what it picked because of it. the rates come from a sample of 512
+struct SortDecision {
+    std::size_t size = 0;
+    std::size_t element_size = 0;
+    double run_rate = 0;            // share of neighbours that break a run, up or down. 1 / average run length
+    double inversion_rate = 0;      // share of pairs out of order, 0.5 for random input and 1 for reversed
+    double duplicate_rate = 0;      // share of neighbours equal once the sample is sorted
+    double key_range = -1;          // largest minus smallest key, integers only
+    const char* algorithm = "";
+    const char* reason = "";
+};
+
+/// @brief one line of a decision for the log: the measurements, then the algorithm and why
+std::ostream& operator<<(std::ostream& out, const SortDecision& decision);
+
+// how far an array is from sorted, by the usual measures of presortedness. equal elements never count as out of order
+struct Disorder {
+    std::size_t size = 0;
+    uint64_t inversions = 0;            // pairs out of order, 0 sorted up to n(n - 1) / 2 reversed
+    std::size_t runs = 0;               // ascending runs, one more than the number of descents
+    std::size_t longest_sorted = 0;     // longest subsequence already in order
+    std::size_t rem = 0;                // fewest elements to take out to leave the rest sorted, size - longest_sorted
+    uint64_t osc = 0;                   // for every pair of neighbours, the elements whose value lies strictly between them
+    std::size_t max_displacement = 0;   // furthest any element is from its place in the sorted array
+};
+
+/// @brief one line of measurements for the log, inversions also as a share of all pairs
+std::ostream& operator<<(std::ostream& out, const Disorder& disorder);
+
+/// @brief measure how disordered an array is, without changing it. O(n log n): ranks the elements with argsort, counts
+/// inversions by merge sorting the ranks, finds the longest sorted subsequence by patience sorting them and osc from
+/// how many elements are below and up to each value
+template <class RandomIt>
+Disorder measure_disorder(RandomIt first, RandomIt last);
+
+// sort with whichever algorithm suits the input, instead of the caller picking one. 32 elements or fewer get insertion
+// sort. otherwise it samples neighbours for runs, random pairs for inversions and a sorted handful for duplicates, and
+// scans integers for their range: arrays made of long runs get natural_merge_sort, integers in a range no bigger than
+// their count get counting_sort, other ints simd_quicksort, other numbers radix_sort and strings msd_string_sort. big
+// elements and heavily duplicated ones get merge_sort, everything else introsort (partial_quicksort's median of three loop).
+// the decision is returned, and written to log if one is given
+template <class RandomIt>
+SortDecision smart_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, std::ostream* log = nullptr);
+
+// sorted container for values that arrive in batches, instead of appending them and sorting everything again.
+// each batch is sorted with merge_sort into a run at the end of one array, then the last run is merged into the one
+// before it while that one is no more than twice as big. the runs shrink at least by half from oldest to newest, so
+// there are O(log n) of them and each value is merged O(log n) times. lookups binary search every run
+template <class T>
+class SortedRuns {
+public:
+    /// @brief sort a batch of values into a new run and merge runs as needed. draws the whole array after each step
+    template <class InputIt>
+    void insert(InputIt first, InputIt last, const Shader* shader = nullptr, GLFWwindow* window = nullptr);
+
+    /// @brief how many stored values are less than value
+    std::size_t rank(const T& value) const;
+
+    /// @brief whether value is stored
+    bool contains(const T& value) const;
+
+    /// @brief merge every run into one
+    /// @return all the values, sorted
+    const std::vector<T>& sorted(const Shader* shader = nullptr, GLFWwindow* window = nullptr);
+
+    std::size_t size() const {return values.size();}
+    std::size_t run_count() const {return bounds.size() - 1;}
+
+private:
+    std::vector<T> values;                  // the runs one after another, oldest and biggest first
+    std::vector<std::size_t> bounds{0};     // run r is values[bounds[r], bounds[r + 1])
+};
+
+/// @brief map a number to an unsigned integer that sorts in the same order, so radix sorts can work on its raw digits
+/// signed ints get their sign bit flipped. floats get every bit flipped when negative and only the sign bit when positive
+/// @param value the integer or float to convert
+/// @return unsigned integer of the same width as value
+template <class T>
+auto radix_key(T value);
+
+/// @brief radix_key for keys whose ties have to stay in order: -0.0 == 0.0, but their bits differ, so both get 0.0's key
+template <class T>
+auto stable_radix_key(T value);
+
+/// @brief whether radix_key takes T: integers and floats of up to 64 bits, so not bool or a wider long double, which
+/// sorts that would key them compare instead
+template <class T>
+constexpr bool has_radix_key = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+
+/// @brief a string's byte at depth as a radix digit: 0 past the end, otherwise the byte as unsigned plus one, so a string
+/// sorts before the longer strings it is a prefix of
+template <class S>
+inline unsigned string_digit(const S& s, std::size_t depth);
+
+/// @brief whether a comes before b, comparing from depth on. the bytes before depth must already be equal
+template <class S>
+bool suffix_less(const S& a, const S& b, std::size_t depth);
+
+/// @brief run task(0) through task(count - 1), each on its own thread, and wait for all of them to finish
+/// @param count the number of threads to start
+/// @param task callable taking the thread's index as an unsigned int
+template <class Func>
+void run_threads(unsigned count, const Func& task);
+
+/// @brief copy one 64 byte cache line with non-temporal stores, so the destination line is not read into the cache
+/// before being overwritten. plain copy without SSE2. call stream_fence() before another thread reads dest
+/// @param dest where to write, must be 64 byte aligned
+/// @param src the 64 bytes to write, any alignment
+inline void stream_line(void* dest, const void* src);
+
+/// @brief make streamed writes from this thread visible to other threads
+inline void stream_fence();
+
+/// @brief merge two sorted arrays into out, taking from a on ties, a staging buffer at a time. each chunk of output is
+/// cut out of a and b by binary search, merged into the buffer with simd_merge (or one element at a time for other
+/// types) and written out with stream_line, so out is never read into the cache. stream_fence() before reading out
+template <class T>
+void streamed_merge(const T* a, std::size_t a_count, const T* b, std::size_t b_count, T* out);
+
+/// @brief the gap for the next pass of a comb sort
+/// @param gap the gap of the last pass, the array size before the first
+/// @return gap divided by 1.3, 11 instead of 9 or 10, and never below 1
+inline std::size_t comb_gap(std::size_t gap);
+
+/// @brief sort a block of 8, 16, 32 or 64 numbers in place with a vectorized bitonic network
+/// @param data the block, any alignment
+/// @param n the block size, must be one of the sizes above
+void sorting_network(int32_t* data, int n);
+void sorting_network(float* data, int n);
+void sorting_network(int64_t* data, int n);
+
+/// @brief sort a block of 8, 16, 32 or 64 numbers that is already bitonic (rises then falls, or falls then rises),
+/// the final merge of sorting_network on its own
+/// @param data the block, any alignment
+/// @param n the block size, must be one of the sizes above
+void bitonic_clean(int32_t* data, int n);
+void bitonic_clean(float* data, int n);
+void bitonic_clean(int64_t* data, int n);
+
+/// @brief compare (data[0], data[1]), (data[2], data[3]) and so on, swapping each pair that is out of order.
+/// int32, float and int64 compare a vector of pairs at a time, other types one pair at a time
+/// @param data the first pair
+/// @param pairs how many pairs to compare
+/// @return how many pairs were swapped
+std::size_t odd_even_exchange(int32_t* data, std::size_t pairs);
+std::size_t odd_even_exchange(float* data, std::size_t pairs);
+std::size_t odd_even_exchange(int64_t* data, std::size_t pairs);
+
+template <class T>
+std::size_t odd_even_exchange(T* data, std::size_t pairs);
+
+/// @brief merge two sorted runs into out a vector at a time. the smaller next vector of the two runs goes through a
+/// bitonic merge network with the larger half of the last merge, the smaller half of the result is written out
+/// @param a first sorted run
+/// @param a_count length of a
+/// @param b second sorted run
+/// @param b_count length of b
+/// @param out where to write the a_count + b_count merged numbers, must not overlap a or b
+void simd_merge(const int32_t* a, std::size_t a_count, const int32_t* b, std::size_t b_count, int32_t* out);
+void simd_merge(const float* a, std::size_t a_count, const float* b, std::size_t b_count, float* out);
+void simd_merge(const int64_t* a, std::size_t a_count, const int64_t* b, std::size_t b_count, int64_t* out);
+
+/// @brief move every number less than pivot to the front of the array and the rest to the back, a vector at a time.
+/// uses AVX-512 compress stores when the cpu has them, AVX2 with a permutation table otherwise, std::partition without either
+/// @param first start of the array
+/// @param last end of the array
+/// @param pivot value to split around
+/// @return pointer to the first number not less than pivot
+int32_t* simd_partition(int32_t* first, int32_t* last, int32_t pivot);
+
+/// @brief quicksort's partition step: move everything less than *pivot before it and the rest after it
+/// @param first start of the range
+/// @param last end of the range
+/// @param pivot the element to split around, anywhere in the range. it is swapped to the end first
+/// @param OG_first, OG_last the whole array, for drawing
+/// @return where the pivot ends up, its place in the sorted range
+template <class RandomIt, class Compare = std::less<>, class Projection = identity_projection>
+RandomIt partition_at(RandomIt first, RandomIt last, RandomIt pivot, const Shader* shader, GLFWwindow* window, RandomIt OG_first, RandomIt OG_last,
+                      Compare comp = {}, Projection proj = {});
+
+/// @brief the middle value of the first, middle and last elements of a range, a pivot that sorted input can't fool
+template <class RandomIt>
+RandomIt median_of_three(RandomIt first, RandomIt last);
+
+/// @brief move the value at root of the max heap [first, last) down until it is no smaller than its children
+template <class RandomIt, class Compare = std::less<>, class Projection = identity_projection>
+void heap_sift_down(RandomIt first, RandomIt last, RandomIt root, Compare comp = {}, Projection proj = {});
+
+/// @brief recursive part of multikey_quicksort, sorting from byte depth on. key_of(element) gives the string, so burstsort
+/// can sort indices of strings with it
+template <class RandomIt, class KeyOf>
+void multikey_quicksort(RandomIt first, RandomIt last, std::size_t depth, const KeyOf& key_of, const Shader* shader, GLFWwindow* window,
+                        RandomIt OG_first, RandomIt OG_last);
+
+/// @brief recursive part of msd_string_sort, sorting from byte depth on. scratch and cache line up with [first, last)
+template <class RandomIt, class T>
+void msd_string_sort(RandomIt first, RandomIt last, std::size_t depth, T* scratch, uint16_t* cache, const Shader* shader, GLFWwindow* window,
+                     RandomIt OG_first, RandomIt OG_last);
+
+/// @brief recursive part of simd_quicksort, depth_limit counts down to the switch to heap sort
+void simd_quicksort(int32_t* first, int32_t* last, int depth_limit, const Shader* shader, GLFWwindow* window, int32_t* OG_first, int32_t* OG_last);
 
 
 
@@ -119,10 +632,109 @@ int64_t benchmark(const Func& function, Args... args) {
     return duration_cast<nanoseconds>(stop - start).count();
 }
 
+/// @brief time the faster algorithms without graphics on arrays too large to draw, printing the results to the terminal
+/// run with the --benchmark flag, no window is created
+void run_benchmarks();
+
+/// @brief strings shaped like request urls, https://host/word/word/number?query, from a handful of hosts and path words,
+/// so that they share long prefixes the way urls from a real access log do
+/// @param n how many to make
+/// @param rng where the randomness comes from
+std::vector<std::string> make_urls(std::size_t n, std::mt19937_64& rng);
+
+/// @brief strings shaped like log lines, an ISO timestamp from one day, a level, a worker and one of a few messages with
+/// numbers in it. every line shares the date, and the times are in random order, like logs gathered from many machines
+/// @param n how many to make
+/// @param rng where the randomness comes from
+std::vector<std::string> make_log_lines(std::size_t n, std::mt19937_64& rng);
+
+/// @brief sort a file of 64 bit keys that can be much bigger than memory. reads chunks that fit in memory_bytes, sorts each
+/// with sample_sort and writes it to a temporary run file next to output, then merges the runs k at a time through
+/// large sequential buffers until one is left. run with --external-sort input output [--text] [--memory MB]
+/// @param input binary file of int64 keys in native byte order, or with text decimal keys separated by whitespace
+/// @param output where to write the sorted keys, in the same format as input
+/// @param memory_bytes how much memory the keys and file buffers may take
+/// @param text read and write the keys as text, one per line on output
+/// @return false, after printing why, if a file could not be read or written
+bool external_sort(const std::string& input, const std::string& output, std::size_t memory_bytes, bool text);
+
+/// @brief merge sorted binary run files into one sorted file. works a block at a time: every loaded key no bigger than
+/// the smallest last key of the loaded blocks is gathered and merged in memory with simd_merge
+/// @param runs the run files, all open at once
+/// @param output where to write the merged keys
+/// @param text write output as text instead of binary
+/// @param buffer_bytes size of the read buffer of each run and of the write buffer
+/// @return false, after printing why, if a file could not be read or written
+bool merge_runs(const std::vector<std::string>& runs, const std::string& output, bool text, std::size_t buffer_bytes);
+
+/// @brief load a file of 64 bit keys and print measure_disorder for it. run with --disorder input [--text]
+/// @param input binary or text file of keys, like external_sort's input. has to fit in memory
+/// @param text read the keys as text
+/// @return false, after printing why, if the file could not be read
+bool print_disorder(const std::string& input, bool text);
+
 
 int size = 50;
 
-int main() {
+int main(int argc, char* argv[]) {
+    // benchmark without opening a window
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        run_benchmarks();
+        return 0;
+    }
+
+    // sort a file too big for memory without opening a window
+    if (argc > 1 && std::string(argv[1]) == "--external-sort") {
+        if (argc < 4) {
+            std::cout << "usage: " << argv[0] << " --external-sort input output [--text] [--memory MB]" << std::endl;
+            return -1;
+        }
+
+        bool text = false;
+        std::size_t memory_mb = 1024;
+        for (int i = 4; i < argc; ++i) {
+            const std::string flag = argv[i];
+            if (flag == "--text") {
+                text = true;
+            }
+            else if (flag == "--memory" && i + 1 == argc) {
+                std::cout << "ERROR. --memory needs a number of MB after it" << std::endl;
+                return -1;
+            }
+            else if (flag == "--memory") {
+                // a whole positive number of megabytes, small enough to count in bytes
+                const std::string value = argv[++i];
+                const auto parsed = std::from_chars(value.data(), value.data() + value.size(), memory_mb);
+                if (parsed.ec != std::errc() || parsed.ptr != value.data() + value.size() || memory_mb == 0
+                    || memory_mb > (std::numeric_limits<std::size_t>::max() >> 20)) {
+                    std::cout << "ERROR. --memory takes a number of MB, not " << value << std::endl;
+                    return -1;
+                }
+            }
+            else {
+                std::cout << "ERROR. unknown option " << flag << std::endl;
+                return -1;
+            }
+        }
+
+        bool sorted = false;
+        const double seconds = static_cast<double>(benchmark([&](){sorted = external_sort(argv[2], argv[3], memory_mb << 20, text);})) / (1e9);
+        if (!sorted) {
+            return -1;
+        }
+        std::cout << "finished external sort in " << seconds << " seconds or " << seconds / 60.0 << " minutes" << std::endl;
+        return 0;
+    }
+
+    // how sorted a file of keys already is
+    if (argc > 1 && std::string(argv[1]) == "--disorder") {
+        if (argc < 3 || argc > 4 || (argc == 4 && std::string(argv[3]) != "--text")) {
+            std::cout << "usage: " << argv[0] << " --disorder input [--text]" << std::endl;
+            return -1;
+        }
+        return print_disorder(argv[2], argc == 4) ? 0 : -1;
+    }
+
     // setup opengl
     GLFWwindow* window = setupWindow(500,500,"Sorting Algorithms");
 
@@ -142,7 +754,7 @@ int main() {
     std::vector<int> vec = change_size(size, shader);
 
     // render loop
-    for (int i = 0; i < 6 && !glfwWindowShouldClose(window); ++i)
+    for (int i = 0; i < 23 && !glfwWindowShouldClose(window); ++i)
     {
         // input
         processInput(window);
@@ -222,6 +834,200 @@ int main() {
                 sleep(1);
                 break;
 
+            case 6:  // radix sort
+                std::cout << "\n\nperforming radix sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){radix_sort(vec.begin(), vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished radix sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 7:  // msd radix sort
+                std::cout << "\n\nperforming msd radix sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){msd_radix_sort(vec.begin(), vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished msd radix sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 8:  // counting sort
+                std::cout << "\n\nperforming counting sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){counting_sort(vec.begin(), vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished counting sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 9:  // merge sort
+                std::cout << "\n\nperforming merge sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){merge_sort(vec.begin(), vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished merge sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 10:  // natural merge sort
+                std::cout << "\n\nperforming natural merge sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){natural_merge_sort(vec.begin(), vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished natural merge sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 11:  // in place merge sort
+                std::cout << "\n\nperforming in place merge sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){inplace_merge_sort(vec.begin(), vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished in place merge sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 12:  // binary insertion sort
+                std::cout << "\n\nperforming binary insertion sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){binary_insertion_sort(vec.begin(), vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished binary insertion sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 13:  // odd even sort
+                std::cout << "\n\nperforming odd even sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){odd_even_sort(vec.begin(), vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished odd even sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 14:  // comb sort
+                std::cout << "\n\nperforming comb sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){comb_sort(vec.begin(), vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished comb sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 15:  // bidirectional comb sort
+                std::cout << "\n\nperforming bidirectional comb sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){bidirectional_comb_sort(vec.begin(), vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished bidirectional comb sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 16:  // select nth
+                std::cout << "\n\nperforming select nth on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){select_nth(vec.begin(), vec.begin() + vec.size() / 2, vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished select nth in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 17:  // partial quicksort
+                std::cout << "\n\nperforming partial quicksort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){partial_quicksort(vec.begin(), vec.begin() + vec.size() / 4, vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished partial quicksort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 18:  // heap select
+                std::cout << "\n\nperforming heap select on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){heap_select(vec.begin(), vec.begin() + vec.size() / 4, vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished heap select in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 19:  // sorted runs
+            {
+                std::cout << "\n\ninserting " << size << " elements into sorted runs 5 at a time..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                SortedRuns<int> runs;
+                seconds = static_cast<double>(benchmark([&](){
+                    for (std::size_t i = 0; i < vec.size(); i += 5) {
+                        runs.insert(vec.begin() + i, vec.begin() + std::min(i + 5, vec.size()), shader, window);
+                    }
+                    vec = runs.sorted(shader, window);
+                })) / (1e9);
+                std::cout << "finished sorted runs in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+            }
+
+            case 20:  // quicksort descending
+                std::cout << "\n\nperforming quicksort descending on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){quicksort(vec.begin(), vec.end(), shader, window, vec.begin(), vec.end(), std::greater<>());})) / (1e9);
+                std::cout << "finished quicksort descending in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 21:  // smart sort
+                std::cout << "\n\nperforming smart sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){smart_sort(vec.begin(), vec.end(), shader, window, &std::cout);})) / (1e9);
+                std::cout << "finished smart sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
+
+            case 22:  // cycle sort
+                std::cout << "\n\nperforming cycle sort on " << size << " elements..." << std::endl;
+                draw_array(vec.begin(), vec.end(), shader, window);
+                sleep(1);
+                std::shuffle(vec.begin(), vec.end(), std::random_device{});
+                sleep(1);
+                seconds = static_cast<double>(benchmark([&](){cycle_sort(vec.begin(), vec.end(), shader, window);})) / (1e9);
+                std::cout << "finished cycle sort in " << seconds << " seconds or " <<  seconds / 60.0 << " minutes" << std::endl;
+                sleep(1);
+                break;
 
             default:
                std::cout << "something went wrong here i " << i << std::endl;
@@ -327,8 +1133,21 @@ void setup_buffers(unsigned int &VBO, unsigned int &EBO, unsigned int &VAO) {
 
 }
 
+template <class T>
+float bar_value(const T& value) {
+    if constexpr (std::is_constructible<float, const T&>::value) {
+        return static_cast<float>(value);
+    }
+    else {
+        return 0.0f;
+    }
+}
+
 template <class RandomIt>
 void draw_array(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window){
+    // nothing to draw to when benchmarking
+    if (window == nullptr) {return;}
+
     // render stuff
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
@@ -336,13 +1155,13 @@ void draw_array(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow*
     int index = 0;
     for (auto i = first; i < last; ++i){
         // height is num/max 
-        float height = static_cast<float>(*i) / static_cast<float>(size);   // change to floats to avoid integer division
+        float height = bar_value(*i) / static_cast<float>(size);   // change to floats to avoid integer division
         glad_glUniform3f(glGetUniformLocation(shader->get_ID(), "color"), height, 0.0f, 1.0f - height);
 
         // transformation, move x to i, scale y to nums[i]
         glm::mat4 trans{1.0f};
         trans = glm::translate(trans, glm::vec3(static_cast<float>(index), 0.0f, 0.0f));
-        trans = glm::scale(trans, glm::vec3(1.0f, static_cast<float>(*i), 1.0f));
+        trans = glm::scale(trans, glm::vec3(1.0f, bar_value(*i), 1.0f));
         shader->setMat4("trans", trans);
 
         // draw
@@ -370,10 +1189,867 @@ std::vector<int> change_size(const int new_size, Shader* shader) {
     return vec;
 }
 
-/* SORTING ALGORITHMS */
+/* BENCHMARKING */
 
-template <class RandomIt>
-void bubble_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+std::vector<std::string> make_urls(std::size_t n, std::mt19937_64& rng) {
+    static const char* const hosts[] = {"www.example.com", "shop.example.com", "api.example.com", "cdn.example.net",
+                                        "accounts.example.org", "blog.example.org", "static.example.net", "m.example.com"};
+    static const char* const words[] = {"products", "category", "search", "user", "orders", "cart", "images", "v1", "v2",
+                                        "items", "reviews", "help", "shoes", "books", "music", "account", "settings", "static"};
+    static const char* const queries[] = {"", "?ref=mail", "?page=", "?sort=price&page=", "?utm_source=feed&id="};
+    auto pick = [&rng](const auto& list) {return list[rng() % std::size(list)];};
+
+    std::vector<std::string> urls(n);
+    for (auto& url : urls) {
+        url = "https://";
+        url += pick(hosts);
+        for (std::size_t segments = 1 + rng() % 3; segments > 0; --segments) {
+            url += '/';
+            url += pick(words);
+        }
+        url += '/';
+        url += std::to_string(rng() % 100000);
+        const std::string query = pick(queries);
+        url += query;
+        if (!query.empty() && query.back() == '=') {
+            url += std::to_string(rng() % 1000);
+        }
+    }
+    return urls;
+}
+
+
+std::vector<std::string> make_log_lines(std::size_t n, std::mt19937_64& rng) {
+    static const char* const levels[] = {"INFO ", "INFO ", "INFO ", "DEBUG", "WARN ", "ERROR"};
+    static const char* const messages[] = {"request handled in ", "cache miss for key ", "retrying connection to shard ",
+                                           "user logged in, session ", "slow query took "};
+
+    std::vector<std::string> lines(n);
+    char timestamp[32];
+    for (auto& line : lines) {
+        const std::size_t millisecond = rng() % (24ul * 60 * 60 * 1000);
+        std::snprintf(timestamp, sizeof(timestamp), "2026-10-17T%02zu:%02zu:%02zu.%03zuZ ", millisecond / 3600000,
+                      millisecond / 60000 % 60, millisecond / 1000 % 60, millisecond % 1000);
+        line = timestamp;
+        line += levels[rng() % std::size(levels)];
+        line += " [worker-" + std::to_string(rng() % 16) + "] ";
+        line += messages[rng() % std::size(messages)];
+        line += std::to_string(rng() % 100000);
+    }
+    return lines;
+}
+
+
+void run_benchmarks() {
+    std::mt19937_64 rng{std::random_device{}()};
+
+    // sort a copy of data, print how long it took and flag it if the result is wrong
+    // checks the result is in order by comp
+    auto time_sort_by = [](const char* name, const auto& data, const auto& comp, const auto& sort) {
+        auto vec = data;
+        const double seconds = static_cast<double>(benchmark([&](){sort(vec);})) / (1e9);
+        std::cout << "    " << name << ": " << seconds << " seconds, "
+                  << static_cast<double>(vec.size()) / seconds / 1e6 << " million keys per second, "
+                  << static_cast<double>(vec.size() * sizeof(vec[0])) / seconds / 1e9 << " GB per second"
+                  << (std::is_sorted(vec.begin(), vec.end(), comp) ? "" : "   NOT SORTED") << std::endl;
+    };
+    auto time_sort = [&](const char* name, const auto& data, const auto& sort) {time_sort_by(name, data, std::less<>(), sort);};
+
+    // how disordered an input is, to read its timings against
+    auto describe = [](const auto& data) {std::cout << "    disorder  : " << measure_disorder(data.begin(), data.end()) << std::endl;};
+
+    // the O(n^2) exchange sorts only get small arrays, starting from the visualizer's
+    for (const std::size_t n : {50ul, 1000ul, 10000ul, 30000ul}) {
+        std::vector<int> values(n);
+        for (auto& value : values) {value = static_cast<int>(rng());}
+
+        std::cout << "\n" << n << " random ints on " << std::thread::hardware_concurrency() << " threads" << std::endl;
+        describe(values);
+        time_sort("bubble    ", values, [](auto& vec){bubble_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("shaker    ", values, [](auto& vec){shaker_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("comb      ", values, [](auto& vec){comb_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("bidi comb ", values, [](auto& vec){bidirectional_comb_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("odd even  ", values, [](auto& vec){odd_even_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("cycle     ", values, [](auto& vec){cycle_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+    }
+
+    // writes into the array per element, for memory that wears out or slows down with every write. only assignments
+    // into the array being sorted count, not ones into scratch buffers. the radix sorts need numbers, so they are left out
+    {
+        static std::size_t writes = 0;
+        static const void* array_first = nullptr;
+        static const void* array_last = nullptr;
+        struct Counted {
+            int value = 0;
+            Counted() = default;
+            Counted(int value) : value(value) {}
+            Counted(const Counted&) = default;
+            Counted& operator=(const Counted& other) {
+                value = other.value;
+                const std::less<const void*> before;
+                if (!before(this, array_first) && before(this, array_last)) {++writes;}
+                return *this;
+            }
+            bool operator<(const Counted& other) const {return value < other.value;}
+        };
+
+        auto count_writes = [](const char* name, const std::vector<Counted>& data, const auto& sort) {
+            auto vec = data;
+            writes = 0;
+            array_first = vec.data();
+            array_last = vec.data() + vec.size();
+            sort(vec);
+            array_first = array_last = nullptr;
+            std::cout << "    " << name << ": " << static_cast<double>(writes) / static_cast<double>(vec.size()) << " writes per element"
+                      << (std::is_sorted(vec.begin(), vec.end()) ? "" : "   NOT SORTED") << std::endl;
+        };
+
+        constexpr std::size_t n = 1000;
+        std::vector<Counted> random_values(n);
+        for (auto& value : random_values) {value = Counted(static_cast<int>(rng()));}
+        std::vector<Counted> nearly_sorted(n);
+        for (std::size_t i = 0; i < n; ++i) {nearly_sorted[i] = Counted(static_cast<int>(i));}
+        for (std::size_t swaps = 0; swaps < n / 100; ++swaps) {std::swap(nearly_sorted[rng() % n], nearly_sorted[rng() % n]);}
+
+        for (const auto* input : {&random_values, &nearly_sorted}) {
+            std::cout << "\n" << n << (input == &random_values ? " random" : " nearly sorted") << " ints, writes" << std::endl;
+            describe(*input);
+            count_writes("bubble    ", *input, [](auto& vec){bubble_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("shaker    ", *input, [](auto& vec){shaker_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("comb      ", *input, [](auto& vec){comb_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("odd even  ", *input, [](auto& vec){odd_even_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("selection ", *input, [](auto& vec){selection_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("insertion ", *input, [](auto& vec){insertion_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("binary ins", *input, [](auto& vec){binary_insertion_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("cycle     ", *input, [](auto& vec){cycle_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("quicksort ", *input, [](auto& vec){quicksort(vec.begin(), vec.end(), nullptr, nullptr, vec.begin(), vec.end());});
+            count_writes("heap sort ", *input, [](auto& vec){heap_select(vec.begin(), vec.end(), vec.end(), nullptr, nullptr);});
+            count_writes("merge sort", *input, [](auto& vec){merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("natural   ", *input, [](auto& vec){natural_merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("in place  ", *input, [](auto& vec){inplace_merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("smart     ", *input, [](auto& vec){smart_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            count_writes("std::sort ", *input, [](auto& vec){std::sort(vec.begin(), vec.end());});
+            count_writes("std stable", *input, [](auto& vec){std::stable_sort(vec.begin(), vec.end());});
+        }
+    }
+
+    // time a selection on a copy of data. checks that the smallest k ended up sorted at the front, or with k = 0
+    // that the median is in the middle with nothing bigger before it and nothing smaller after it
+    auto time_selection = [](const char* name, const auto& data, std::size_t k, const auto& select) {
+        auto vec = data;
+        const double seconds = static_cast<double>(benchmark([&](){select(vec);})) / (1e9);
+
+        auto expected = data;
+        bool correct = true;
+        if (k > 0) {
+            std::partial_sort(expected.begin(), expected.begin() + k, expected.end());
+            correct = std::equal(expected.begin(), expected.begin() + k, vec.begin());
+        }
+        else {
+            const auto nth = expected.size() / 2;
+            std::nth_element(expected.begin(), expected.begin() + nth, expected.end());
+            correct = vec[nth] == expected[nth]
+                && std::all_of(vec.begin(), vec.begin() + nth, [&](auto value){return !(vec[nth] < value);})
+                && std::all_of(vec.begin() + nth, vec.end(), [&](auto value){return !(value < vec[nth]);});
+        }
+        std::cout << "    " << name << ": " << seconds << " seconds" << (correct ? "" : "   WRONG") << std::endl;
+    };
+
+    for (const std::size_t n : {100000ul, 1000000ul, 10000000ul}) {
+        // 64 bit ids spread over the whole range
+        std::vector<int64_t> ids(n);
+        for (auto& id : ids) {id = static_cast<int64_t>(rng());}
+
+        std::cout << "\n" << n << " random 64 bit ids" << std::endl;
+        describe(ids);
+        time_sort("quicksort ", ids, [](auto& vec){quicksort(vec.begin(), vec.end(), nullptr, nullptr, vec.begin(), vec.end());});
+        time_sort("radix sort", ids, [](auto& vec){radix_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("counting  ", ids, [](auto& vec){counting_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("merge sort", ids, [](auto& vec){merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("streamed  ", ids, [](auto& vec){merge_sort(vec.begin(), vec.end(), nullptr, nullptr, true);});
+        time_sort("msd radix ", ids, [](auto& vec){msd_radix_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("par radix ", ids, [](auto& vec){parallel_radix_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("sample    ", ids, [](auto& vec){sample_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("std::sort ", ids, [](auto& vec){std::sort(vec.begin(), vec.end());});
+        time_sort("smart     ", ids, [](auto& vec){smart_sort(vec.begin(), vec.end(), nullptr, nullptr, &std::cout);});
+
+        // sort_by should cost the same as the kernel it picks plus a reverse
+        std::cout << n << " random 64 bit ids, descending" << std::endl;
+        time_sort_by("quicksort ", ids, std::greater<>(), [](auto& vec){
+            quicksort(vec.begin(), vec.end(), nullptr, nullptr, vec.begin(), vec.end(), std::greater<>());
+        });
+        time_sort_by("sort_by   ", ids, std::greater<>(), [](auto& vec){sort_by(vec.begin(), vec.end(), nullptr, nullptr, std::greater<>());});
+        time_sort_by("std::sort ", ids, std::greater<>(), [](auto& vec){std::sort(vec.begin(), vec.end(), std::greater<>());});
+
+        // only the smallest 100 in order, or only the median
+        std::cout << n << " random 64 bit ids, smallest 100 then median" << std::endl;
+        time_selection("heap sel  ", ids, 100, [](auto& vec){heap_select(vec.begin(), vec.begin() + 100, vec.end(), nullptr, nullptr);});
+        time_selection("smallest k", ids, 100, [](auto& vec){
+            const auto smallest = smallest_k(vec.begin(), vec.end(), 100);
+            std::copy(smallest.begin(), smallest.end(), vec.begin());
+        });
+        time_selection("partial qs", ids, 100, [](auto& vec){partial_quicksort(vec.begin(), vec.begin() + 100, vec.end(), nullptr, nullptr);});
+        time_selection("std::part ", ids, 100, [](auto& vec){std::partial_sort(vec.begin(), vec.begin() + 100, vec.end());});
+        time_selection("full sort ", ids, 100, [](auto& vec){sample_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_selection("select nth", ids, 0, [](auto& vec){select_nth(vec.begin(), vec.begin() + vec.size() / 2, vec.end(), nullptr, nullptr);});
+        time_selection("std::nth  ", ids, 0, [](auto& vec){std::nth_element(vec.begin(), vec.begin() + vec.size() / 2, vec.end());});
+
+        // floats with both signs
+        std::uniform_real_distribution<float> dist(-1e6f, 1e6f);
+        std::vector<float> floats(n);
+        for (auto& f : floats) {f = dist(rng);}
+
+        std::cout << n << " random floats" << std::endl;
+        describe(floats);
+        time_sort("quicksort ", floats, [](auto& vec){quicksort(vec.begin(), vec.end(), nullptr, nullptr, vec.begin(), vec.end());});
+        time_sort("radix sort", floats, [](auto& vec){radix_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("msd radix ", floats, [](auto& vec){msd_radix_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("std::sort ", floats, [](auto& vec){std::sort(vec.begin(), vec.end());});
+
+        // 32 bit keys, the case parallel radix sort is built for
+        std::vector<uint32_t> keys(n);
+        for (auto& key : keys) {key = static_cast<uint32_t>(rng());}
+
+        std::cout << n << " random 32 bit keys on " << std::thread::hardware_concurrency() << " threads" << std::endl;
+        describe(keys);
+        time_sort("radix sort", keys, [](auto& vec){radix_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("counting  ", keys, [](auto& vec){counting_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("par radix ", keys, [](auto& vec){parallel_radix_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("streaming ", keys, [](auto& vec){parallel_radix_sort(vec.begin(), vec.end(), nullptr, nullptr, true);});
+        time_sort("merge sort", keys, [](auto& vec){merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("streamed  ", keys, [](auto& vec){merge_sort(vec.begin(), vec.end(), nullptr, nullptr, true);});
+
+        // same as change_size makes, every number from 1 to n
+        std::vector<int> permutation(n);
+        for (std::size_t i = 0; i < n; ++i) {permutation[i] = static_cast<int>(i + 1);}
+        std::shuffle(permutation.begin(), permutation.end(), rng);
+
+        std::cout << n << " shuffled numbers 1 to n" << std::endl;
+        describe(permutation);
+        time_sort("quicksort ", permutation, [](auto& vec){quicksort(vec.begin(), vec.end(), nullptr, nullptr, vec.begin(), vec.end());});
+        time_sort("simd qsort", permutation, [](auto& vec){simd_quicksort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("sample    ", permutation, [](auto& vec){sample_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("radix sort", permutation, [](auto& vec){radix_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("counting  ", permutation, [](auto& vec){counting_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("int sort  ", permutation, [](auto& vec){integer_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("comb      ", permutation, [](auto& vec){comb_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("bidi comb ", permutation, [](auto& vec){bidirectional_comb_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+
+        // already sorted except for one percent of the numbers moved somewhere random
+        std::vector<int> nearly_sorted(n);
+        for (std::size_t i = 0; i < n; ++i) {nearly_sorted[i] = static_cast<int>(i + 1);}
+        for (std::size_t swaps = 0; swaps < n / 100; ++swaps) {std::swap(nearly_sorted[rng() % n], nearly_sorted[rng() % n]);}
+
+        std::cout << n << " shuffled numbers 1 to n, then " << n << " nearly sorted" << std::endl;
+        describe(nearly_sorted);
+        time_sort("merge sort", permutation, [](auto& vec){merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("natural   ", permutation, [](auto& vec){natural_merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("in place  ", permutation, [](auto& vec){inplace_merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("std stable", permutation, [](auto& vec){std::stable_sort(vec.begin(), vec.end());});
+        time_sort("merge sort", nearly_sorted, [](auto& vec){merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("natural   ", nearly_sorted, [](auto& vec){natural_merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("in place  ", nearly_sorted, [](auto& vec){inplace_merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("std stable", nearly_sorted, [](auto& vec){std::stable_sort(vec.begin(), vec.end());});
+
+        // bitonic sort does the same work on any input of a given size, the others vary with the input
+        std::vector<int> reversed(n);
+        for (std::size_t i = 0; i < n; ++i) {reversed[i] = static_cast<int>(n - i);}
+        std::vector<int> all_equal(n, 7);
+
+        std::cout << n << " shuffled, nearly sorted, reversed and equal numbers" << std::endl;
+        for (const auto* input : {&permutation, &nearly_sorted, &reversed, &all_equal}) {
+            describe(*input);
+            time_sort("bitonic   ", *input, [](auto& vec){bitonic_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            time_sort("simd qsort", *input, [](auto& vec){simd_quicksort(vec.begin(), vec.end(), nullptr, nullptr);});
+            time_sort("std::sort ", *input, [](auto& vec){std::sort(vec.begin(), vec.end());});
+            time_sort("smart     ", *input, [](auto& vec){smart_sort(vec.begin(), vec.end(), nullptr, nullptr, &std::cout);});
+        }
+
+        // 200 byte records, ordered by id. sorting by key moves each record once
+        struct Record {
+            int64_t id;
+            char payload[192];
+            bool operator<(const Record& other) const {return id < other.id;}
+        };
+        if (n <= 1000000) {
+            std::vector<Record> records(n);
+            for (auto& record : records) {
+                record.id = static_cast<int64_t>(rng() % (1ul << 31));
+                std::memset(record.payload, static_cast<int>(record.id), sizeof(record.payload));
+            }
+
+            std::cout << n << " records of " << sizeof(Record) << " bytes" << std::endl;
+            describe(records);
+            time_sort("merge sort", records, [](auto& vec){merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+            time_sort("std::sort ", records, [](auto& vec){std::sort(vec.begin(), vec.end());});
+            time_sort("smart     ", records, [](auto& vec){smart_sort(vec.begin(), vec.end(), nullptr, nullptr, &std::cout);});
+            time_sort("by key 64 ", records, [](auto& vec){sort_by_key(vec.begin(), vec.end(), [](const Record& record){return record.id;}, nullptr, nullptr);});
+            time_sort("by key 32 ", records, [](auto& vec){
+                sort_by_key(vec.begin(), vec.end(), [](const Record& record){return static_cast<int32_t>(record.id);}, nullptr, nullptr);
+            });
+            time_sort("sort_by id", records, [](auto& vec){sort_by(vec.begin(), vec.end(), nullptr, nullptr, std::less<>(), &Record::id);});
+            time_sort_by("id desc   ", records, [](const Record& a, const Record& b){return b.id < a.id;}, [](auto& vec){
+                sort_by(vec.begin(), vec.end(), nullptr, nullptr, std::greater<>(), &Record::id);
+            });
+        }
+
+        // three columns of the same rows put in a random order. gathering into copies needs as much memory again as
+        // the columns, the cycle walks a bit or a byte per row
+        {
+            std::vector<std::size_t> order(n);
+            std::iota(order.begin(), order.end(), 0);
+            std::shuffle(order.begin(), order.end(), rng);
+
+            std::vector<int64_t> id_column(n);
+            std::vector<double> price_column(n);
+            std::vector<int32_t> count_column(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                id_column[i] = static_cast<int64_t>(i);
+                price_column[i] = static_cast<double>(i) / 8;
+                count_column[i] = static_cast<int32_t>(i);
+            }
+
+            const double column_mb = static_cast<double>(n * (sizeof(int64_t) + sizeof(double) + sizeof(int32_t))) / (1 << 20);
+            std::cout << n << " rows of 3 columns (" << column_mb << " MB) permuted" << std::endl;
+            auto time_permute = [&](const char* name, double extra_mb, const auto& permute) {
+                auto ids = id_column;
+                auto prices = price_column;
+                auto counts = count_column;
+                const double seconds = static_cast<double>(benchmark([&](){permute(ids, prices, counts);})) / (1e9);
+
+                bool correct = true;
+                for (std::size_t i = 0; i < n && correct; ++i) {
+                    correct = ids[i] == static_cast<int64_t>(order[i]) && prices[i] == static_cast<double>(order[i]) / 8
+                        && counts[i] == static_cast<int32_t>(order[i]);
+                }
+                std::cout << "    " << name << ": " << seconds << " seconds, " << extra_mb << " MB extra" << (correct ? "" : "   WRONG") << std::endl;
+            };
+
+            time_permute("gather    ", column_mb, [&](auto& ids, auto& prices, auto& counts){
+                auto gather = [&](auto& column) {
+                    std::remove_reference_t<decltype(column)> copy(n);
+                    for (std::size_t i = 0; i < n; ++i) {copy[i] = column[order[i]];}
+                    column.swap(copy);
+                };
+                gather(ids);
+                gather(prices);
+                gather(counts);
+            });
+            time_permute("cycles    ", static_cast<double>(n) / 8 / (1 << 20), [&](auto& ids, auto& prices, auto& counts){
+                permute_columns(order.begin(), n, ids.begin(), prices.begin(), counts.begin());
+            });
+            time_permute("parallel  ", static_cast<double>(n) / (1 << 20), [&](auto& ids, auto& prices, auto& counts){
+                parallel_permute_columns(order.begin(), n, ids.begin(), prices.begin(), counts.begin());
+            });
+        }
+
+        // string keys. ten million would take gigabytes, so only the smaller sizes
+        if (n <= 1000000) {
+            const std::vector<std::string> urls = make_urls(n, rng);
+            const std::vector<std::string> log_lines = make_log_lines(n, rng);
+            for (const auto* input : {&urls, &log_lines}) {
+                std::cout << n << (input == &urls ? " urls" : " log lines") << ", like " << input->front() << std::endl;
+                describe(*input);
+                time_sort("std::sort ", *input, [](auto& vec){std::sort(vec.begin(), vec.end());});
+                time_sort("merge sort", *input, [](auto& vec){merge_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+                time_sort("multikey  ", *input, [](auto& vec){multikey_quicksort(vec.begin(), vec.end(), nullptr, nullptr);});
+                time_sort("msd string", *input, [](auto& vec){msd_string_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+                time_sort("burstsort ", *input, [](auto& vec){burstsort(vec.begin(), vec.end(), nullptr, nullptr);});
+                time_sort("smart     ", *input, [](auto& vec){smart_sort(vec.begin(), vec.end(), nullptr, nullptr, &std::cout);});
+            }
+
+            // keys that cost something to work out: urls by a normalized form (lower case, no scheme, www. or query) and
+            // log lines by the number they end with. std::sort works out both keys on every compare
+            auto normalized_url = [](const std::string& url) {
+                std::string key = url.substr(url.find("://") + 3);
+                key.erase(std::min(key.find('?'), key.size()));
+                if (key.compare(0, 4, "www.") == 0) {key.erase(0, 4);}
+                for (char& c : key) {c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));}
+                return key;
+            };
+            auto trailing_number = [](const std::string& line) {
+                int64_t number = 0;
+                std::from_chars(line.data() + line.rfind(' ') + 1, line.data() + line.size(), number);
+                return number;
+            };
+            auto time_keyed = [&](const char* name, const auto& data, const auto& key_of) {
+                std::cout << n << " " << name << std::endl;
+                auto by_key = [&](const std::string& a, const std::string& b) {return key_of(a) < key_of(b);};
+                uint64_t compares = 0;
+                auto vec = data;
+                double seconds = static_cast<double>(benchmark([&](){
+                    std::sort(vec.begin(), vec.end(), [&](const std::string& a, const std::string& b){++compares; return by_key(a, b);});
+                })) / (1e9);
+                std::cout << "    std::sort : " << seconds << " seconds, " << compares << " compares, " << compares * 2
+                          << " keys computed" << (std::is_sorted(vec.begin(), vec.end(), by_key) ? "" : "   NOT SORTED") << std::endl;
+
+                vec = data;
+                DecorateStats stats;
+                seconds = static_cast<double>(benchmark([&](){stats = decorated_sort(vec.begin(), vec.end(), key_of, nullptr, nullptr);})) / (1e9);
+                std::cout << "    decorated : " << seconds << " seconds, " << stats
+                          << (std::is_sorted(vec.begin(), vec.end(), by_key) ? "" : "   NOT SORTED") << std::endl;
+            };
+            time_keyed("urls by normalized url", urls, normalized_url);
+            time_keyed("log lines by trailing number", log_lines, trailing_number);
+        }
+
+        // values arriving in batches, kept sorted after every batch. re-sorting everything each time is quadratic,
+        // so it only gets the sizes that finish in seconds. simd_quicksort, since quicksort's last element pivot is quadratic on the
+        // already sorted front
+        std::vector<int> arrivals(n);
+        for (auto& value : arrivals) {value = static_cast<int>(rng());}
+
+        for (const std::size_t batch : {1000ul, 10000ul}) {
+            std::cout << n << " random ints inserted " << batch << " at a time" << std::endl;
+            auto time_inserts = [&](const char* name, auto&& insert_batch) {
+                std::size_t below = 0;  // query after every batch so neither side can put off its work
+                const double seconds = static_cast<double>(benchmark([&](){
+                    for (std::size_t i = 0; i < n; i += batch) {
+                        below += insert_batch(arrivals.begin() + i, arrivals.begin() + std::min(i + batch, n));
+                    }
+                })) / (1e9);
+                std::cout << "    " << name << ": " << seconds << " seconds, "
+                          << static_cast<double>(n) / seconds / 1e6 << " million inserts per second"
+                          << " (" << below << ")" << std::endl;
+            };
+
+            SortedRuns<int> runs;
+            time_inserts("runs      ", [&runs](auto batch_first, auto batch_last) {
+                runs.insert(batch_first, batch_last);
+                return runs.rank(0);
+            });
+            if (n / batch * n <= 100000000ul) {
+                std::vector<int> resorted;
+                time_inserts("re-sort   ", [&resorted](auto batch_first, auto batch_last) {
+                    resorted.insert(resorted.end(), batch_first, batch_last);
+                    simd_quicksort(resorted.begin(), resorted.end(), nullptr, nullptr);
+                    return static_cast<std::size_t>(std::lower_bound(resorted.begin(), resorted.end(), 0) - resorted.begin());
+                });
+            }
+        }
+
+        // enum like column with a handful of values
+        std::vector<int> statuses(n);
+        for (auto& status : statuses) {status = static_cast<int>(rng() % 12);}
+
+        std::cout << n << " numbers from 0 to 11" << std::endl;
+        describe(statuses);
+        time_sort("radix sort", statuses, [](auto& vec){radix_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("sample    ", statuses, [](auto& vec){sample_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("counting  ", statuses, [](auto& vec){counting_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+        time_sort("int sort  ", statuses, [](auto& vec){integer_sort(vec.begin(), vec.end(), nullptr, nullptr);});
+
+        // many small blocks, the leaves of quicksort and the radix sorts
+        std::vector<int> small(n / 64 * 64);
+        for (auto& value : small) {value = static_cast<int>(rng());}
+
+        auto time_blocks = [&small](const char* name, const auto& sort_block) {
+            auto vec = small;
+            const double seconds = static_cast<double>(benchmark([&](){
+                for (auto block = vec.begin(); block != vec.end(); block += 64) {sort_block(block, block + 64);}
+            })) / (1e9);
+
+            bool sorted = true;
+            for (auto block = vec.begin(); block != vec.end(); block += 64) {sorted = sorted && std::is_sorted(block, block + 64);}
+
+            std::cout << "    " << name << ": " << seconds << " seconds" << (sorted ? "" : "   NOT SORTED") << std::endl;
+        };
+
+        std::cout << small.size() / 64 << " blocks of 64 random ints" << std::endl;
+        time_blocks("insertion ", [](auto block, auto block_end){insertion_sort(block, block_end, nullptr, nullptr);});
+        time_blocks("binary ins", [](auto block, auto block_end){binary_insertion_sort(block, block_end, nullptr, nullptr);});
+        time_blocks("network   ", [](auto block, auto block_end){network_sort(block, block_end, nullptr, nullptr);});
+    }
+}
+
+/* EXTERNAL SORT */
+
+// reads keys from a file a large block at a time, straight into the caller's array for binary files
+class KeyReader {
+public:
+    KeyReader(const std::string& path, bool text, std::size_t buffer_bytes) : text(text) {
+        file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) {
+            return;
+        }
+        // the reads are already big, stdio's own buffer would only add a copy
+        std::setvbuf(file, nullptr, _IONBF, 0);
+#if defined(POSIX_FADV_SEQUENTIAL)
+        posix_fadvise(fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        if (text) {
+            buffer.resize(buffer_bytes);
+        }
+    }
+
+    ~KeyReader() {
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+
+    KeyReader(const KeyReader&) = delete;
+    KeyReader& operator=(const KeyReader&) = delete;
+
+    bool is_open() const {return file != nullptr;}
+    bool failed() const {return error;}
+
+    // read up to count keys, fewer only at the end of the file or on an error
+    std::size_t read(int64_t* keys, std::size_t count) {
+        if (!text) {
+            const std::size_t bytes = std::fread(keys, 1, count * sizeof(int64_t), file);
+            error = error || std::ferror(file) || bytes % sizeof(int64_t) != 0;
+            return bytes / sizeof(int64_t);
+        }
+
+        std::size_t n = 0;
+        while (n < count) {
+            int c = peek();
+            while (c != EOF && std::isspace(c)) {
+                ++begin;
+                c = peek();
+            }
+            if (c == EOF) {
+                break;
+            }
+
+            const bool negative = c == '-';
+            if (negative) {
+                ++begin;
+                c = peek();
+            }
+            if (c == EOF || !std::isdigit(c)) {
+                error = true;
+                break;
+            }
+
+            uint64_t value = 0;
+            while (c != EOF && std::isdigit(c)) {
+                value = value * 10 + static_cast<uint64_t>(c - '0');
+                ++begin;
+                c = peek();
+            }
+            keys[n++] = static_cast<int64_t>(negative ? 0 - value : value);
+        }
+        return n;
+    }
+
+private:
+    // next character of a text file, refilling the buffer when it runs out
+    int peek() {
+        if (begin == end && !at_end) {
+            begin = 0;
+            end = std::fread(buffer.data(), 1, buffer.size(), file);
+            at_end = end == 0;
+            error = error || std::ferror(file);
+        }
+        return begin < end ? static_cast<unsigned char>(buffer[begin]) : EOF;
+    }
+
+    std::FILE* file = nullptr;
+    bool text;
+    bool error = false;
+    std::vector<char> buffer;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    bool at_end = false;
+};
+
+
+// writes keys to a file through a large buffer, as raw bytes or as text one per line
+class KeyWriter {
+public:
+    KeyWriter(const std::string& path, bool text, std::size_t buffer_bytes) : text(text), buffer(std::max<std::size_t>(buffer_bytes, 64)) {
+        file = std::fopen(path.c_str(), "wb");
+        if (file != nullptr) {
+            std::setvbuf(file, nullptr, _IONBF, 0);
+        }
+    }
+
+    ~KeyWriter() {
+        close();
+    }
+
+    KeyWriter(const KeyWriter&) = delete;
+    KeyWriter& operator=(const KeyWriter&) = delete;
+
+    bool is_open() const {return file != nullptr;}
+
+    void write(int64_t key) {
+        // room for the longest key and a newline
+        if (buffer.size() - used < 24) {
+            flush();
+        }
+        if (text) {
+            used = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), key).ptr - buffer.data();
+            buffer[used++] = '\n';
+        }
+        else {
+            std::memcpy(buffer.data() + used, &key, sizeof(key));
+            used += sizeof(key);
+        }
+    }
+
+    // a whole sorted chunk, binary ones skip the buffer
+    void write(const int64_t* keys, std::size_t count) {
+        if (text) {
+            for (std::size_t i = 0; i < count; ++i) {write(keys[i]);}
+            return;
+        }
+        flush();
+        error = error || file == nullptr || std::fwrite(keys, sizeof(int64_t), count, file) != count;
+    }
+
+    // flush and close the file, false if any write failed
+    bool close() {
+        if (file == nullptr) {
+            return !error;
+        }
+        flush();
+        error = std::fclose(file) != 0 || error;
+        file = nullptr;
+        return !error;
+    }
+
+private:
+    void flush() {
+        error = error || file == nullptr || std::fwrite(buffer.data(), 1, used, file) != used;
+        used = 0;
+    }
+
+    std::FILE* file = nullptr;
+    bool text;
+    bool error = false;
+    std::vector<char> buffer;
+    std::size_t used = 0;
+};
+
+
+bool external_sort(const std::string& input, const std::string& output, std::size_t memory_bytes, bool text) {
+    constexpr std::size_t io_block = 1 << 20;   // smaller reads start paying for seeks between the run files
+    constexpr std::size_t max_fan_in = 512;     // run files open at once
+
+    // sample_sort needs a scratch copy of the chunk. a merge holds a read buffer per run, the keys gathered from them
+    // and a scratch copy of those, plus the write buffer
+    const std::size_t chunk_keys = std::max<std::size_t>(memory_bytes / (2 * sizeof(int64_t)), 1);
+    const std::size_t fan_in = std::clamp<std::size_t>(memory_bytes / (3 * io_block), 2, max_fan_in);
+
+    KeyReader reader(input, text, io_block);
+    if (!reader.is_open()) {
+        std::cout << "ERROR. could not open " << input << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> runs;
+    std::size_t run_count = 0;
+    auto remove_runs = [&runs]() {
+        for (const auto& run : runs) {std::remove(run.c_str());}
+    };
+
+    // sort memory sized chunks into run files
+    std::unique_ptr<int64_t[]> chunk(new int64_t[chunk_keys]);
+    while (true) {
+        const std::size_t n = reader.read(chunk.get(), chunk_keys);
+        if (reader.failed()) {
+            std::cout << "ERROR. could not read keys from " << input << std::endl;
+            remove_runs();
+            return false;
+        }
+        if (n == 0 && !runs.empty()) {
+            break;
+        }
+        sample_sort(chunk.get(), chunk.get() + n, nullptr, nullptr);
+
+        // the whole file fit in memory
+        const bool last_chunk = n < chunk_keys;
+        if (last_chunk && runs.empty()) {
+            KeyWriter writer(output, text, io_block);
+            writer.write(chunk.get(), n);
+            if (!writer.is_open() || !writer.close()) {
+                std::cout << "ERROR. could not write " << output << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+        runs.push_back(output + ".run" + std::to_string(run_count++));
+        KeyWriter writer(runs.back(), false, io_block);
+        writer.write(chunk.get(), n);
+        if (!writer.is_open() || !writer.close()) {
+            std::cout << "ERROR. could not write " << runs.back() << std::endl;
+            remove_runs();
+            return false;
+        }
+        std::cout << "sorted run " << runs.size() << " of " << n << " keys" << std::endl;
+
+        if (last_chunk) {
+            break;
+        }
+    }
+    chunk.reset();
+
+    // merge fan_in runs at a time until one pass can finish them all
+    const std::size_t buffer_bytes = std::max(memory_bytes / (3 * fan_in + 1), io_block);
+    while (runs.size() > fan_in) {
+        std::vector<std::string> merged;
+        for (std::size_t i = 0; i < runs.size(); i += fan_in) {
+            const std::vector<std::string> group(runs.begin() + i, runs.begin() + std::min(i + fan_in, runs.size()));
+            merged.push_back(output + ".run" + std::to_string(run_count++));
+
+            const bool ok = merge_runs(group, merged.back(), false, buffer_bytes);
+            for (const auto& run : group) {std::remove(run.c_str());}
+            if (!ok) {
+                for (std::size_t j = i + group.size(); j < runs.size(); ++j) {std::remove(runs[j].c_str());}
+                runs = merged;
+                remove_runs();
+                return false;
+            }
+        }
+        std::cout << "merged " << runs.size() << " runs into " << merged.size() << std::endl;
+        runs = merged;
+    }
+
+    const bool ok = merge_runs(runs, output, text, buffer_bytes);
+    remove_runs();
+    return ok;
+}
+
+
+bool merge_runs(const std::vector<std::string>& runs, const std::string& output, bool text, std::size_t buffer_bytes) {
+    const std::size_t buffer_keys = std::max<std::size_t>(buffer_bytes / sizeof(int64_t), 1);
+
+    // each run's next block of keys
+    struct Run {
+        std::unique_ptr<KeyReader> reader;
+        std::vector<int64_t> keys;
+        std::size_t next = 0;
+        std::size_t count = 0;
+    };
+    std::vector<Run> sources(runs.size());
+
+    // load the next block of a run once the last one is used up, false once the run is
+    auto refill = [buffer_keys](Run& run) {
+        if (run.next == run.count) {
+            run.count = run.reader->read(run.keys.data(), buffer_keys);
+            run.next = 0;
+        }
+        return run.count > 0;
+    };
+
+    for (std::size_t r = 0; r < runs.size(); ++r) {
+        sources[r].reader = std::make_unique<KeyReader>(runs[r], false, buffer_bytes);
+        if (!sources[r].reader->is_open()) {
+            std::cout << "ERROR. could not open " << runs[r] << std::endl;
+            return false;
+        }
+        sources[r].keys.resize(buffer_keys);
+    }
+
+    KeyWriter writer(output, text, buffer_bytes);
+    if (!writer.is_open()) {
+        std::cout << "ERROR. could not write " << output << std::endl;
+        return false;
+    }
+
+    // every key up to the smallest last key of the loaded blocks can be written now: no run has a smaller one left
+    // to load. those keys are gathered and merged in pairs with simd_merge, a vector at a time instead of a compare
+    // per key. the run holding that last key is used up, so each round loads at least one new block
+    std::unique_ptr<int64_t[]> gathered(new int64_t[runs.size() * buffer_keys]);
+    std::unique_ptr<int64_t[]> scratch(new int64_t[runs.size() * buffer_keys]);
+    while (true) {
+        int64_t bound = std::numeric_limits<int64_t>::max();
+        bool any = false;
+        for (auto& run : sources) {
+            if (refill(run)) {
+                bound = std::min(bound, run.keys[run.count - 1]);
+                any = true;
+            }
+        }
+        if (!any) {
+            break;
+        }
+
+        std::vector<std::size_t> bounds{0};
+        for (auto& run : sources) {
+            const auto run_first = run.keys.begin() + run.next;
+            const auto run_last = std::upper_bound(run_first, run.keys.begin() + run.count, bound);
+            if (run_first != run_last) {
+                std::copy(run_first, run_last, gathered.get() + bounds.back());
+                bounds.push_back(bounds.back() + (run_last - run_first));
+                run.next += run_last - run_first;
+            }
+        }
+
+        // same rounds as kway_merge, but through buffers that are reused every time
+        int64_t* from = gathered.get();
+        int64_t* to = scratch.get();
+        while (bounds.size() > 2) {
+            std::vector<std::size_t> merged_bounds{0};
+            for (std::size_t r = 0; r + 1 < bounds.size(); r += 2) {
+                const std::size_t middle = bounds[r + 1];
+                const std::size_t run_last = (r + 2 < bounds.size()) ? bounds[r + 2] : middle;
+                simd_merge(from + bounds[r], middle - bounds[r], from + middle, run_last - middle, to + bounds[r]);
+                merged_bounds.push_back(run_last);
+            }
+            bounds = merged_bounds;
+            std::swap(from, to);
+        }
+        writer.write(from, bounds.back());
+    }
+
+    for (std::size_t r = 0; r < runs.size(); ++r) {
+        if (sources[r].reader->failed()) {
+            std::cout << "ERROR. could not read " << runs[r] << std::endl;
+            return false;
+        }
+    }
+    if (!writer.close()) {
+        std::cout << "ERROR. could not write " << output << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+bool print_disorder(const std::string& input, bool text) {
+    constexpr std::size_t io_block = 1 << 20;
+
+    KeyReader reader(input, text, io_block);
+    if (!reader.is_open()) {
+        std::cout << "ERROR. could not open " << input << std::endl;
+        return false;
+    }
+
+    std::vector<int64_t> keys;
+    while (true) {
+        const std::size_t used = keys.size();
+        keys.resize(used + io_block / sizeof(int64_t));
+        const std::size_t n = reader.read(keys.data() + used, keys.size() - used);
+        keys.resize(used + n);
+        if (reader.failed()) {
+            std::cout << "ERROR. could not read keys from " << input << std::endl;
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+    }
+
+    std::cout << measure_disorder(keys.begin(), keys.end()) << std::endl;
+    return true;
+}
+
+
+/* SORTING ALGORITHMS */
+
+template <class Compare, class Projection, class A, class B>
+inline bool projected_less(Compare& comp, Projection& proj, const A& a, const B& b) {
+    return std::invoke(comp, std::invoke(proj, a), std::invoke(proj, b));
+}
+
+
+template <class RandomIt, class Compare, class Projection>
+void bubble_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp, Projection proj) {
 
     bool swapped = true;  // end early if no swaps made
 
@@ -385,7 +2061,7 @@ void bubble_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow
         for (auto current = first; current < last - 1 - (i - first); ++current){
 
             // compare adjacent cells, swap if out of order
-            if (*current > *(current + 1)) {
+            if (projected_less(comp, proj, *(current + 1), *current)) {
                 std::swap(*current, *(current + 1));
                 swapped = true;
                 // draw after every write
@@ -397,8 +2073,8 @@ void bubble_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow
 }
 
 
-template <class RandomIt>
-void shaker_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+template <class RandomIt, class Compare, class Projection>
+void shaker_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp, Projection proj) {
 
     auto left_border = first;
     auto right_border = last;
@@ -406,7 +2082,7 @@ void shaker_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow
     while (left_border < right_border) {
         // move left to right, pushing big items, biggest item is in place
         for (auto current = left_border; current < right_border - 1; ++current){
-            if (*current > *(current + 1)){
+            if (projected_less(comp, proj, *(current + 1), *current)){
                 std::swap(*current, *(current + 1));
                 draw_array(first, last, shader, window);
             }
@@ -415,7 +2091,7 @@ void shaker_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow
 
         // move right to left, pushing small items, smallest item is in place
         for (auto current = right_border - 1; current > left_border; --current){
-            if (*current < *(current - 1)){
+            if (projected_less(comp, proj, *current, *(current - 1))){
                 std::swap(*current, *(current - 1));
                 draw_array(first, last, shader, window);
             }
@@ -425,75 +2101,332 @@ void shaker_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow
 
 }
 
-template <class RandomIt>
-void selection_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window)
-{
-    // first last represent bounds of unsorted array
-    // first is the element being swapped with smallest value
-    auto first_unsorted = first;
-    while (first_unsorted < last)
-    {
-        // find the smallest item, by default is first element (as iterator)
-        auto smallest = first_unsorted;
-
-        for (auto current = first_unsorted + 1; current != last; ++current)
-        {
-            // if item is smaller, it is new smallest
-            if (*current < *smallest)
-            {
-                smallest = current;
-                draw_array(first, last, shader, window);
-            }
-        }
-
-        // swap the values of first and smallest
-        if (smallest != first_unsorted)
-        {
-            std::swap(*smallest, *first_unsorted);
-            draw_array(first, last, shader, window);
-        }
-
-        ++first_unsorted;  // move to next unsorted element
+inline std::size_t comb_gap(std::size_t gap) {
+    gap = gap * 10 / 13;
+    if (gap == 9 || gap == 10) {
+        return 11;
     }
+    return std::max<std::size_t>(gap, 1);
 }
 
+
 template <class RandomIt>
-void insertion_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window)
-{
-    // iterate through unsorted array, starting from second element
-    for (auto index = first + 1; index < last; ++index)
-    {
-        // store value of what is being inserted
-        const auto current_val = *index;
+void comb_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    if (last - first < 2) {
+        return;
+    }
+    std::size_t gap = last - first;
+    bool swapped = true;
 
-        // store location of where to insert in sorted portion
-        auto inserted_pos = index;
+    // once the gap reaches 1 this is bubble sort on an array that is almost in order
+    while (gap > 1 || swapped) {
+        gap = comb_gap(gap);
+        swapped = false;
 
-        // while not accessing first position and the next
-        // value is lessthan current value
-        while (inserted_pos > first && *(inserted_pos - 1) > current_val)
-        {
-            // shuffle larger value right one
-            *inserted_pos = *(inserted_pos - 1);
-            --inserted_pos;
-            draw_array(first, last, shader, window);
+        for (auto current = first; current + gap < last; ++current) {
+            if (*(current + gap) < *current) {
+                std::swap(*current, *(current + gap));
+                swapped = true;
+                draw_array(first, last, shader, window);
+            }
         }
-
-        // hole is made for value, now insert into place
-        *inserted_pos = current_val;
-        draw_array(first, last, shader, window);
     }
 }
 
 
-template <typename RandomIt>
-void quicksort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, RandomIt OG_first, RandomIt OG_last) {
+template <class RandomIt>
+void bidirectional_comb_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    if (last - first < 2) {
+        return;
+    }
+    std::size_t gap = last - first;
+    bool swapped = true;
 
-    // base case. Return if only 1 element
-    if (first >= last) {return;}
+    while (gap > 1 || swapped) {
+        gap = comb_gap(gap);
+        swapped = false;
+
+        // up the array pushing big items towards the end
+        for (auto current = first; current + gap < last; ++current) {
+            if (*(current + gap) < *current) {
+                std::swap(*current, *(current + gap));
+                swapped = true;
+                draw_array(first, last, shader, window);
+            }
+        }
+
+        // back down pulling small items towards the beginning
+        for (auto current = last - gap; current != first;) {
+            --current;
+            if (*(current + gap) < *current) {
+                std::swap(*current, *(current + gap));
+                swapped = true;
+                draw_array(first, last, shader, window);
+            }
+        }
+    }
+}
+
+
+template <class T>
+std::size_t odd_even_exchange(T* data, std::size_t pairs) {
+    std::size_t swaps = 0;
+    for (std::size_t i = 0; i < pairs; ++i) {
+        if (data[2 * i + 1] < data[2 * i]) {
+            std::swap(data[2 * i], data[2 * i + 1]);
+            ++swaps;
+        }
+    }
+    return swaps;
+}
+
+
+template <class RandomIt, class Sort>
+void sort_flat_copy(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, const Sort& sort) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    std::vector<T> copy(std::make_move_iterator(first), std::make_move_iterator(last));
+    sort(copy.begin(), copy.end(), shader, window);
+    std::move(copy.begin(), copy.end(), first);
+    draw_array(first, last, shader, window);
+}
+
+
+template <class RandomIt>
+void odd_even_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    if constexpr (!is_contiguous_iterator<RandomIt>) {
+        sort_flat_copy(first, last, shader, window, [](auto copy_first, auto copy_last, auto* copy_shader, auto* copy_window) {
+            odd_even_sort(copy_first, copy_last, copy_shader, copy_window);
+        });
+        return;
+    }
+
+    const std::size_t n = last - first;
+    if (n < 2) {
+        return;
+    }
+    auto* data = &*first;
+
+    // worker threads cannot draw, and small arrays are done before the threads would start
+    const unsigned threads = window != nullptr || n < (1u << 14) ? 1 : std::max(1u, std::thread::hardware_concurrency());
+
+    if (threads == 1) {
+        for (bool swapped = true; swapped;) {
+            swapped = false;
+            for (std::size_t phase = 0; phase < 2; ++phase) {
+                swapped = odd_even_exchange(data + phase, (n - phase) / 2) != 0 || swapped;
+                draw_array(first, last, shader, window);
+            }
+        }
+        return;
+    }
+
+    // every thread waits here until all of them have finished the pass
+    std::atomic<unsigned> arrived{0};
+    std::atomic<unsigned> generation{0};
+    auto barrier = [&]() {
+        const unsigned current = generation.load(std::memory_order_acquire);
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == threads) {
+            arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+        }
+        else {
+            while (generation.load(std::memory_order_acquire) == current) {std::this_thread::yield();}
+        }
+    };
+
+    // round r counts its swaps in swaps[r % 3], so it can be read after the round while the next one counts in
+    // another and the one after that is cleared
+    std::atomic<std::size_t> swaps[3] = {};
+
+    run_threads(threads, [&](unsigned t) {
+        for (std::size_t round = 0; ; ++round) {
+            if (t == 0) {swaps[(round + 1) % 3].store(0, std::memory_order_relaxed);}
+
+            std::size_t swapped = 0;
+            for (std::size_t phase = 0; phase < 2; ++phase) {
+                const std::size_t pairs = (n - phase) / 2;
+                const std::size_t pair_first = pairs * t / threads;
+                const std::size_t pair_last = pairs * (t + 1) / threads;
+                swapped += odd_even_exchange(data + phase + 2 * pair_first, pair_last - pair_first);
+
+                if (phase == 1) {swaps[round % 3].fetch_add(swapped, std::memory_order_relaxed);}
+                barrier();
+            }
+
+            if (swaps[round % 3].load(std::memory_order_relaxed) == 0) {
+                break;
+            }
+        }
+    });
+    draw_array(first, last, shader, window);
+}
+
+
+template <class RandomIt, class Compare, class Projection>
+void selection_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp, Projection proj)
+{
+    // first last represent bounds of unsorted array
+    // first is the element being swapped with smallest value
+    auto first_unsorted = first;
+    while (first_unsorted < last)
+    {
+        // find the smallest item, by default is first element (as iterator)
+        auto smallest = first_unsorted;
+
+        for (auto current = first_unsorted + 1; current != last; ++current)
+        {
+            // if item is smaller, it is new smallest
+            if (projected_less(comp, proj, *current, *smallest))
+            {
+                smallest = current;
+                draw_array(first, last, shader, window);
+            }
+        }
+
+        // swap the values of first and smallest
+        if (smallest != first_unsorted)
+        {
+            std::swap(*smallest, *first_unsorted);
+            draw_array(first, last, shader, window);
+        }
+
+        ++first_unsorted;  // move to next unsorted element
+    }
+}
+
+template <class RandomIt>
+void cycle_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    auto equal = [](const T& a, const T& b) {return !(a < b) && !(b < a);};
+
+    for (auto cycle_start = first; last - cycle_start > 1; ++cycle_start)
+    {
+        T item = *cycle_start;
+
+        // item belongs after everything smaller than it, and after any copies of it already put in place
+        auto find_place = [&]() {
+            auto place = cycle_start;
+            for (auto current = cycle_start + 1; current != last; ++current)
+            {
+                if (*current < item) {++place;}
+            }
+            while (place != cycle_start && equal(item, *place)) {++place;}
+            return place;
+        };
+
+        auto place = find_place();
+        if (place == cycle_start) {continue;}    // already in place, costs no write
+
+        // put item down and pick up what it replaces, until the cycle comes back round to its start
+        while (true)
+        {
+            T displaced = std::move(*place);
+            *place = std::move(item);
+            item = std::move(displaced);
+            draw_array(first, last, shader, window);
+
+            if (place == cycle_start) {break;}
+            place = find_place();
+        }
+    }
+}
+
+template <class RandomIt, class Compare, class Projection>
+void insertion_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp, Projection proj)
+{
+    // iterate through unsorted array, starting from second element
+    for (auto index = first + 1; index < last; ++index)
+    {
+        // store value of what is being inserted
+        const auto current_val = *index;
+
+        // store location of where to insert in sorted portion
+        auto inserted_pos = index;
+
+        // while not accessing first position and the next
+        // value is lessthan current value
+        while (inserted_pos > first && projected_less(comp, proj, current_val, *(inserted_pos - 1)))
+        {
+            // shuffle larger value right one
+            *inserted_pos = *(inserted_pos - 1);
+            --inserted_pos;
+            draw_array(first, last, shader, window);
+        }
+
+        // hole is made for value, now insert into place
+        *inserted_pos = current_val;
+        draw_array(first, last, shader, window);
+    }
+}
+
+template <class RandomIt>
+void binary_insertion_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window)
+{
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    for (auto index = first + 1; index < last; ++index)
+    {
+        // already bigger than everything sorted so far, common on nearly sorted input
+        if (!(*index < *(index - 1))) {continue;}
+
+        T current_val = std::move(*index);
+
+        // upper bound of current_val in the sorted portion, halving the range each step without branching on the compare
+        auto base = first;
+        auto length = index - first;
+        while (length > 1)
+        {
+            const auto half = length / 2;
+            base = (current_val < *(base + half)) ? base : base + half;
+            length -= half;
+        }
+        const auto inserted_pos = base + !(current_val < *base);
+
+        // shift everything after the spot right by one in a single move
+        std::move_backward(inserted_pos, index, index + 1);
+
+        *inserted_pos = std::move(current_val);
+        draw_array(first, last, shader, window);
+    }
+}
+
+template <typename RandomIt, class Compare, class Projection>
+void quicksort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, RandomIt OG_first, RandomIt OG_last,
+               Compare comp, Projection proj) {
+
+    // base case. Return if only 1 element
+    if (first >= last) {return;}
+
+    // when nothing is drawn, finish small partitions with a sorting network instead of partitioning down to one element.
+    // the networks only know <, so other orders finish with insertion sort
+    if (window == nullptr && last - first <= 64) {
+        if constexpr (is_natural_order<Compare, Projection, typename std::iterator_traits<RandomIt>::value_type>) {
+            network_sort(first, last, shader, window);
+        }
+        else {
+            insertion_sort(first, last, shader, window, comp, proj);
+        }
+        return;
+    }
 
     // set pivot as last element
     // finding pivot in better way may improve performance
+    RandomIt pivot_pos = partition_at(first, last, last - 1, shader, window, OG_first, OG_last, comp, proj);
+
+    // recursively do quicksort before and after pivot
+    // do not include pivot itself, it is in final place
+    quicksort(first, pivot_pos, shader, window, OG_first, OG_last, comp, proj);
+    quicksort(pivot_pos + 1, last, shader, window, OG_first, OG_last, comp, proj);
+}
+
+template <class RandomIt, class Compare, class Projection>
+RandomIt partition_at(RandomIt first, RandomIt last, RandomIt pivot, const Shader* shader, GLFWwindow* window, RandomIt OG_first, RandomIt OG_last,
+                      Compare comp, Projection proj) {
+    if (pivot != last - 1) {
+        std::swap(*pivot, *(last - 1));
+        draw_array(OG_first, OG_last, shader, window);
+    }
     const auto pivot_value = *(last - 1);
 
     // move all values larger than pivot to right of pivot
@@ -507,7 +2440,7 @@ void quicksort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow*
     {
         // if value in array is less than pivot value,
         // start stacking on left side of array
-        if (*j < pivot_value)
+        if (projected_less(comp, proj, *j, pivot_value))
         {
             std::swap(*pivot_pos, *j);
             ++pivot_pos;
@@ -518,11 +2451,2516 @@ void quicksort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow*
     // swap first value larger than pivot with pivot
     std::swap(*pivot_pos, *(last - 1));
     draw_array(OG_first, OG_last, shader, window);
+    return pivot_pos;
+}
 
-    // recursively do quicksort before and after pivot
-    // do not include pivot itself, it is in final place
-    quicksort(first, pivot_pos, shader, window, OG_first, OG_last);
-    quicksort(pivot_pos + 1, last, shader, window, OG_first, OG_last);
+
+template <class RandomIt>
+RandomIt median_of_three(RandomIt first, RandomIt last) {
+    RandomIt a = first;
+    RandomIt b = first + (last - first) / 2;
+    RandomIt c = last - 1;
+    if (*b < *a) {std::swap(a, b);}
+    if (*c < *b) {b = (*c < *a) ? a : c;}
+    return b;
+}
+
+
+template <class RandomIt, class Compare, class Projection>
+void heap_sift_down(RandomIt first, RandomIt last, RandomIt root, Compare comp, Projection proj) {
+    const auto count = last - first;
+    auto parent = root - first;
+
+    while (2 * parent + 1 < count) {
+        auto child = 2 * parent + 1;
+        if (child + 1 < count && projected_less(comp, proj, *(first + child), *(first + child + 1))) {
+            ++child;
+        }
+        if (!projected_less(comp, proj, *(first + parent), *(first + child))) {
+            break;
+        }
+        std::swap(*(first + parent), *(first + child));
+        parent = child;
+    }
+}
+
+
+template <class RandomIt, class Compare, class Projection>
+void heap_select(RandomIt first, RandomIt middle, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp, Projection proj) {
+    if (first == middle) {
+        return;
+    }
+    auto less = [&](const auto& a, const auto& b) {return projected_less(comp, proj, a, b);};
+    std::make_heap(first, middle, less);
+    draw_array(first, last, shader, window);
+
+    // the top of the heap is the biggest of the smallest seen so far, anything smaller takes its place
+    for (auto current = middle; current != last; ++current) {
+        if (less(*current, *first)) {
+            std::swap(*current, *first);
+            heap_sift_down(first, middle, first, comp, proj);
+            draw_array(first, last, shader, window);
+        }
+    }
+
+    std::sort_heap(first, middle, less);
+    draw_array(first, last, shader, window);
+}
+
+
+template <class InputIt>
+std::vector<typename std::iterator_traits<InputIt>::value_type> smallest_k(InputIt first, InputIt last, std::size_t k) {
+    std::vector<typename std::iterator_traits<InputIt>::value_type> heap;
+    if (k == 0) {
+        return heap;
+    }
+    heap.reserve(k);
+
+    for (; first != last; ++first) {
+        if (heap.size() < k) {
+            heap.push_back(*first);
+            std::push_heap(heap.begin(), heap.end());
+        }
+        else if (*first < heap.front()) {
+            heap.front() = *first;
+            heap_sift_down(heap.begin(), heap.end(), heap.begin());
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end());
+    return heap;
+}
+
+
+template <class RandomIt>
+void select_nth(RandomIt first, RandomIt nth, RandomIt last, int depth_limit, const Shader* shader, GLFWwindow* window, RandomIt OG_first, RandomIt OG_last) {
+    while (last - first > 1) {
+        // too many bad pivots, a heap of everything up to nth keeps it at n log n
+        if (depth_limit-- == 0) {
+            heap_select(first, nth + 1, last, shader, nullptr);
+            draw_array(OG_first, OG_last, shader, window);
+            return;
+        }
+
+        const auto n = last - first;
+        RandomIt pivot;
+        if (n > 600) {
+            // Floyd-Rivest: the window holds about n^(2/3) elements, placed so the value that belongs at nth almost
+            // surely falls inside it. selecting nth within the window leaves a pivot close to the right value there
+            const double size = static_cast<double>(n);
+            const double index = static_cast<double>(nth - first);
+            const double z = std::log(size);
+            const double sample = 0.5 * std::exp(2.0 * z / 3.0);
+            const double spread = 0.5 * std::sqrt(z * sample * (size - sample) / size) * (index < size / 2 ? -1.0 : 1.0);
+
+            const auto window_first = static_cast<std::ptrdiff_t>(std::clamp(index - index * sample / size + spread, 0.0, index));
+            const auto window_last = static_cast<std::ptrdiff_t>(std::clamp(index + (size - index) * sample / size + spread, index, size - 1));
+            select_nth(first + window_first, nth, first + window_last + 1, depth_limit, shader, window, OG_first, OG_last);
+            pivot = nth;
+        }
+        else {
+            pivot = median_of_three(first, last);
+        }
+
+        const RandomIt split = partition_at(first, last, pivot, shader, window, OG_first, OG_last);
+        if (split == nth) {
+            return;
+        }
+        if (nth < split) {
+            last = split;
+        }
+        else {
+            first = split + 1;
+        }
+    }
+}
+
+
+template <class RandomIt>
+void select_nth(RandomIt first, RandomIt nth, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    if (last - first < 2 || nth == last) {
+        return;
+    }
+
+    int depth_limit = 0;
+    for (auto n = last - first; n > 1; n >>= 1) {depth_limit += 2;}
+
+    select_nth(first, nth, last, depth_limit, shader, window, first, last);
+}
+
+
+template <class RandomIt>
+void partial_quicksort(RandomIt first, RandomIt middle, RandomIt last, int depth_limit, const Shader* shader, GLFWwindow* window, RandomIt OG_first, RandomIt OG_last) {
+    while (first < middle && last - first > 1) {
+        // too many bad pivots, heap_select keeps it at n log n
+        if (depth_limit-- == 0) {
+            heap_select(first, middle, last, shader, nullptr);
+            draw_array(OG_first, OG_last, shader, window);
+            return;
+        }
+
+        const RandomIt split = partition_at(first, last, median_of_three(first, last), shader, window, OG_first, OG_last);
+
+        // everything after the pivot is too big to be wanted
+        if (middle <= split) {
+            last = split;
+            continue;
+        }
+
+        // the pivot is wanted, so everything before it is too and gets sorted whole. only the front of the rest is wanted
+        partial_quicksort(first, split, split, depth_limit, shader, window, OG_first, OG_last);
+        first = split + 1;
+    }
+}
+
+
+template <class RandomIt>
+void partial_quicksort(RandomIt first, RandomIt middle, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    if (first == middle) {
+        return;
+    }
+
+    // splitting the wanted part off first with floyd-rivest pivots is much cheaper than partitioning the whole
+    // array around median of three pivots when only a few are wanted
+    select_nth(first, middle - 1, last, shader, window);
+
+    int depth_limit = 0;
+    for (auto n = middle - first; n > 1; n >>= 1) {depth_limit += 2;}
+
+    partial_quicksort(first, middle - 1, middle - 1, depth_limit, shader, window, first, last);
+}
+
+
+template <class RandomIt>
+std::vector<std::size_t> argsort(RandomIt first, RandomIt last) {
+    return argsort(first, last, [](const auto& element) {return element;});
+}
+
+
+template <class RandomIt, class KeyFunc>
+std::vector<std::size_t> argsort(RandomIt first, RandomIt last, KeyFunc key_of) {
+    using Key = std::decay_t<decltype(key_of(*first))>;
+    const std::size_t n = last - first;
+    std::vector<std::size_t> order(n);
+
+    if constexpr (std::is_arithmetic<Key>::value && !std::is_same<Key, bool>::value && sizeof(Key) <= 4) {
+        if (n <= std::numeric_limits<uint32_t>::max()) {
+            // key on top, index below it: sorting the numbers sorts by key, ties by index
+            std::vector<uint64_t> packed(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                packed[i] = (static_cast<uint64_t>(stable_radix_key(key_of(*(first + i)))) << 32) | i;
+            }
+            radix_sort(packed.begin(), packed.end(), nullptr, nullptr);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                order[i] = static_cast<uint32_t>(packed[i]);
+            }
+            return order;
+        }
+    }
+
+    struct KeyIndex {
+        Key key;
+        std::size_t index;
+        bool operator<(const KeyIndex& other) const {return key < other.key;}
+    };
+    std::vector<KeyIndex> pairs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        pairs[i] = {key_of(*(first + i)), i};
+    }
+    merge_sort(pairs.begin(), pairs.end(), nullptr, nullptr);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        order[i] = pairs[i].index;
+    }
+    return order;
+}
+
+
+template <class RandomIt, class IndexIt>
+void apply_permutation(RandomIt first, RandomIt last, IndexIt order, const Shader* shader, GLFWwindow* window) {
+    const std::size_t n = last - first;
+    std::vector<bool> done(n, false);
+
+    for (std::size_t start = 0; start < n; ++start) {
+        if (done[start] || *(order + start) == start) {
+            continue;
+        }
+
+        // lift the first element of the cycle out, pull each element of the cycle back into the hole it leaves, and
+        // drop the lifted one into the last hole
+        auto lifted = std::move(*(first + start));
+        std::size_t hole = start;
+        while (true) {
+            done[hole] = true;
+            const std::size_t source = *(order + hole);
+            if (source == start) {
+                break;
+            }
+            *(first + hole) = std::move(*(first + source));
+            draw_array(first, last, shader, window);
+            hole = source;
+        }
+        *(first + hole) = std::move(lifted);
+        draw_array(first, last, shader, window);
+    }
+}
+
+
+template <class IndexIt, class... RandomIts>
+void permute_columns(IndexIt order, std::size_t n, RandomIts... columns) {
+    std::vector<bool> done(n, false);
+
+    for (std::size_t start = 0; start < n; ++start) {
+        if (done[start] || *(order + start) == start) {
+            continue;
+        }
+
+        // same walk as apply_permutation, moving a whole row each step
+        auto lifted = std::make_tuple(std::move(*(columns + start))...);
+        std::size_t hole = start;
+        while (true) {
+            done[hole] = true;
+            const std::size_t source = *(order + hole);
+            if (source == start) {
+                break;
+            }
+            ((*(columns + hole) = std::move(*(columns + source))), ...);
+            hole = source;
+        }
+        std::apply([&](auto&... values){((*(columns + hole) = std::move(values)), ...);}, lifted);
+    }
+}
+
+
+template <class IndexIt, class... RandomIts>
+void parallel_permute_columns(IndexIt order, std::size_t n, RandomIts... columns) {
+    const unsigned threads = n < (1u << 16) ? 1 : std::max(1u, std::thread::hardware_concurrency());
+    if (threads == 1) {
+        permute_columns(order, n, columns...);
+        return;
+    }
+
+    using Row = std::tuple<typename std::iterator_traits<RandomIts>::value_type...>;
+    auto is_break = [](std::size_t row) {return (static_cast<uint64_t>(row) * 0x9E3779B97F4A7C15ull) >> 54 == 0;};
+    auto block_first = [n, threads](unsigned t) {return n * t / threads;};
+
+    // the walk from one break to the next
+    struct Segment {
+        std::size_t start;          // the break it starts from
+        Row lifted;                 // the row that was at start
+        std::size_t last_hole;      // takes the row that was at next_break
+        std::size_t next_break;
+    };
+    std::vector<std::vector<Segment>> segments(threads);
+    std::vector<char> visited(n, 0);    // a byte, not a bit, so threads never write the same memory
+
+    // pull every row back one place along its cycle, from each break up to the next
+    run_threads(threads, [&](unsigned t) {
+        for (std::size_t start = block_first(t); start < block_first(t + 1); ++start) {
+            if (!is_break(start)) {
+                continue;
+            }
+
+            Segment segment{start, Row(std::move(*(columns + start))...), start, start};
+            std::size_t hole = start;
+            while (true) {
+                visited[hole] = 1;
+                const std::size_t source = *(order + hole);
+                if (is_break(source)) {
+                    segment.last_hole = hole;
+                    segment.next_break = source;
+                    break;
+                }
+                ((*(columns + hole) = std::move(*(columns + source))), ...);
+                hole = source;
+            }
+            segments[t].push_back(std::move(segment));
+        }
+    });
+
+    // the last hole of each walk takes the row set aside by the walk from the next break. every thread's segments are
+    // in order of their starts, so it can be found by binary search in the list of the thread that owns the break
+    run_threads(threads, [&](unsigned t) {
+        for (const auto& segment : segments[t]) {
+            unsigned owner = static_cast<unsigned>(segment.next_break * threads / n);
+            while (block_first(owner + 1) <= segment.next_break) {++owner;}
+            while (block_first(owner) > segment.next_break) {--owner;}
+
+            auto& list = segments[owner];
+            auto found = std::lower_bound(list.begin(), list.end(), segment.next_break,
+                                          [](const Segment& other, std::size_t row){return other.start < row;});
+            std::apply([&](auto&... values){((*(columns + segment.last_hole) = std::move(values)), ...);}, found->lifted);
+        }
+    });
+
+    // cycles that missed every break. a thread walks such a cycle once, from the first of its rows it comes to, and marks
+    // the rest of its rows on the way so it never walks the cycle again. only the thread that owns the smallest row of
+    // the cycle moves it, so each cycle costs one walk per thread with a row in it instead of one walk per row
+    run_threads(threads, [&](unsigned t) {
+        for (std::size_t start = block_first(t); start < block_first(t + 1); ++start) {
+            if (visited[start] || *(order + start) == start) {
+                continue;
+            }
+
+            // every row of this thread's block in the cycle comes after start, so start is the smallest if any of them is
+            std::size_t smallest = start;
+            for (std::size_t row = *(order + start); row != start; row = *(order + row)) {
+                if (row >= block_first(t) && row < block_first(t + 1)) {visited[row] = 1;}
+                smallest = std::min(smallest, row);
+            }
+            if (smallest != start) {
+                continue;
+            }
+
+            auto lifted = std::make_tuple(std::move(*(columns + start))...);
+            std::size_t hole = start;
+            for (std::size_t source = *(order + hole); source != start; source = *(order + hole)) {
+                ((*(columns + hole) = std::move(*(columns + source))), ...);
+                hole = source;
+            }
+            std::apply([&](auto&... values){((*(columns + hole) = std::move(values)), ...);}, lifted);
+        }
+    });
+}
+
+
+template <class RandomIt, class KeyFunc>
+void sort_by_key(RandomIt first, RandomIt last, KeyFunc key_of, const Shader* shader, GLFWwindow* window) {
+    const std::vector<std::size_t> order = argsort(first, last, key_of);
+    apply_permutation(first, last, order.begin(), shader, window);
+}
+
+
+template <class RandomIt, class Compare, class Projection>
+void sort_by(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, Compare comp, Projection proj) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    using Key = std::decay_t<std::invoke_result_t<Projection&, const T&>>;
+    constexpr bool identity = std::is_same_v<Projection, identity_projection>;
+    constexpr bool ascending = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<Key>>;
+    constexpr bool descending = std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<Key>>;
+    constexpr bool number = has_radix_key<Key>;
+
+    if (last - first < 2) {
+        return;
+    }
+
+    if constexpr (number && identity && (ascending || descending)) {
+        if constexpr (std::is_integral_v<Key>) {
+            integer_sort(first, last, shader, window);
+        }
+        else {
+            radix_sort(first, last, shader, window);
+        }
+        if constexpr (descending) {
+            std::reverse(first, last);
+            draw_array(first, last, shader, window);
+        }
+    }
+    else if constexpr (number && ascending) {
+        sort_by_key(first, last, [&](const T& element){return static_cast<Key>(std::invoke(proj, element));}, shader, window);
+    }
+    else if constexpr (number && descending) {
+        // radix_key is unsigned, so flipping its bits turns the order around without reordering equal keys
+        using Flipped = decltype(radix_key(std::declval<Key>()));
+        sort_by_key(first, last, [&](const T& element){
+            return static_cast<Flipped>(~stable_radix_key(static_cast<Key>(std::invoke(proj, element))));
+        }, shader, window);
+    }
+    else if constexpr (ascending && identity) {
+        merge_sort(first, last, shader, window);
+    }
+    else if constexpr (ascending) {
+        sort_by_key(first, last, [&](const T& element){return static_cast<Key>(std::invoke(proj, element));}, shader, window);
+    }
+    else {
+        merge_sort(first, last, shader, window, false, [&](const T& a, const T& b){return projected_less(comp, proj, a, b);});
+    }
+}
+
+
+std::ostream& operator<<(std::ostream& out, const DecorateStats& stats) {
+    return out << stats.size << " keys computed once, " << stats.compared << " left to the comparator, "
+               << stats.full_compares << " full compares, " << stats.saved() << " saved against log2(n!) = "
+               << stats.comparison_bound;
+}
+
+
+template <class RandomIt, class KeyFunc, class Compare>
+DecorateStats decorated_sort(RandomIt first, RandomIt last, KeyFunc key_of, const Shader* shader, GLFWwindow* window, Compare comp) {
+    using Key = std::decay_t<decltype(key_of(*first))>;
+    constexpr bool ascending = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<Key>>;
+    constexpr bool descending = std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<Key>>;
+    constexpr bool numeric = (ascending || descending) && has_radix_key<Key>;
+    constexpr bool text = (ascending || descending) && std::is_convertible<const Key&, std::string_view>::value;
+    const std::size_t n = last - first;
+
+    DecorateStats stats;
+    stats.size = n;
+    stats.comparison_bound = static_cast<uint64_t>(std::lgamma(static_cast<double>(n) + 1) / std::log(2.0));
+
+    std::vector<Key> keys;
+    keys.reserve(n);
+    for (RandomIt i = first; i != last; ++i) {
+        keys.push_back(key_of(*i));
+    }
+    stats.key_calls = n;
+
+    // 8 bytes of a string key from offset on, zeros past its end. flipped for descending like everything else
+    auto text_prefix = [&keys](auto index, std::size_t offset) {
+        const std::string_view key(keys[index]);
+        uint64_t prefix = 0;
+        for (std::size_t byte = offset; byte < offset + 8; ++byte) {
+            prefix = (prefix << 8) | (byte < key.size() ? static_cast<unsigned char>(key[byte]) : 0u);
+        }
+        return descending ? ~prefix : prefix;
+    };
+
+    // how many bytes keys[order[begin]] to keys[order[end - 1]] all start with, and whether they are the same string
+    auto shared_bytes = [&keys](auto begin, auto end) {
+        const std::string_view head(keys[*begin]);
+        std::size_t shared = head.size();
+        bool same = true;
+        for (auto i = begin + 1; i != end; ++i) {
+            const std::string_view key(keys[*i]);
+            shared = std::mismatch(head.begin(), head.begin() + shared, key.begin(), key.end()).first - head.begin();
+            same = same && key.size() == head.size();
+        }
+        return std::make_pair(shared, same && shared == head.size());
+    };
+
+    std::vector<uint64_t> prefixes(n, 0);
+    if constexpr (numeric) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto key = static_cast<uint64_t>(stable_radix_key(keys[i]));
+            prefixes[i] = descending ? ~key : key;
+        }
+    }
+    else if constexpr (text) {
+        if (n > 0) {
+            std::vector<std::size_t> all(n);
+            std::iota(all.begin(), all.end(), 0);
+            const std::size_t offset = shared_bytes(all.begin(), all.end()).first;
+            for (std::size_t i = 0; i < n; ++i) {
+                prefixes[i] = text_prefix(i, offset);
+            }
+        }
+    }
+    std::vector<std::size_t> order = argsort(prefixes.begin(), prefixes.end());
+
+    // runs of equal prefixes still to sort. numbers fit their prefix, so theirs are already in order
+    std::vector<std::pair<std::size_t, std::size_t>> pending;
+    auto push_ties = [&](std::size_t begin, std::size_t end) {
+        while (begin < end) {
+            std::size_t run_end = begin + 1;
+            while (run_end < end && prefixes[order[run_end]] == prefixes[order[begin]]) {
+                ++run_end;
+            }
+            if (run_end - begin > 1) {
+                pending.emplace_back(begin, run_end);
+            }
+            begin = run_end;
+        }
+    };
+    if (!numeric) {
+        push_ties(0, n);
+    }
+
+    auto counted = [&](std::size_t a, std::size_t b) {
+        ++stats.full_compares;
+        return comp(keys[a], keys[b]);
+    };
+    while (!pending.empty()) {
+        const auto [begin, end] = pending.back();
+        pending.pop_back();
+
+        if constexpr (text) {
+            // a handful of keys is cheaper to compare than to decorate again
+            if (end - begin > 16) {
+                const auto [offset, same] = shared_bytes(order.begin() + begin, order.begin() + end);
+                if (same) {
+                    continue;
+                }
+
+                std::vector<uint64_t> next(end - begin);
+                for (std::size_t i = 0; i < next.size(); ++i) {
+                    next[i] = text_prefix(order[begin + i], offset);
+                }
+                if (std::adjacent_find(next.begin(), next.end(), std::not_equal_to<>()) != next.end()) {
+                    const std::vector<std::size_t> run_order = argsort(next.begin(), next.end());
+                    std::vector<std::size_t> run(next.size());
+                    for (std::size_t i = 0; i < run.size(); ++i) {
+                        run[i] = order[begin + run_order[i]];
+                        prefixes[run[i]] = next[run_order[i]];
+                    }
+                    std::copy(run.begin(), run.end(), order.begin() + begin);
+                    push_ties(begin, end);
+                    continue;
+                }
+            }
+        }
+
+        stats.compared += end - begin;
+        std::stable_sort(order.begin() + begin, order.begin() + end, counted);
+    }
+
+    apply_permutation(first, last, order.begin(), shader, window);
+    return stats;
+}
+
+
+std::ostream& operator<<(std::ostream& out, const SortDecision& decision) {
+    out << decision.size << " elements of " << decision.element_size << " bytes, "
+        << decision.run_rate * 100 << "% run breaks, " << decision.inversion_rate * 100 << "% inversions, "
+        << decision.duplicate_rate * 100 << "% duplicates";
+    if (decision.key_range >= 0) {
+        out << ", key range " << decision.key_range;
+    }
+    return out << " -> " << decision.algorithm << " (" << decision.reason << ")";
+}
+
+
+std::ostream& operator<<(std::ostream& out, const Disorder& disorder) {
+    const double pairs = static_cast<double>(disorder.size) * (static_cast<double>(disorder.size) - 1) / 2;
+    return out << disorder.size << " elements, " << disorder.inversions << " inversions ("
+               << (pairs > 0 ? static_cast<double>(disorder.inversions) / pairs * 100 : 0) << "% of pairs), "
+               << disorder.runs << " runs, longest sorted subsequence " << disorder.longest_sorted << " (rem " << disorder.rem
+               << "), osc " << disorder.osc << ", max displacement " << disorder.max_displacement;
+}
+
+
+template <class RandomIt>
+Disorder measure_disorder(RandomIt first, RandomIt last) {
+    const std::size_t n = last - first;
+    Disorder disorder;
+    disorder.size = n;
+    if (n == 0) {
+        return disorder;
+    }
+
+    // rank[i] is where element i lands in a stable sort, so equal elements are ranked in the order they already are
+    const std::vector<std::size_t> order = argsort(first, last);
+    std::vector<std::size_t> rank(n);
+    for (std::size_t k = 0; k < n; ++k) {rank[order[k]] = k;}
+
+    disorder.runs = 1;
+    for (std::size_t i = 1; i < n; ++i) {
+        disorder.runs += *(first + i) < *(first + i - 1);
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        disorder.max_displacement = std::max(disorder.max_displacement, rank[i] > i ? rank[i] - i : i - rank[i]);
+    }
+
+    // tails[l] is the smallest rank that ends a sorted subsequence of length l + 1
+    std::vector<std::size_t> tails;
+    for (const std::size_t r : rank) {
+        const auto tail = std::lower_bound(tails.begin(), tails.end(), r);
+        if (tail == tails.end()) {
+            tails.push_back(r);
+        }
+        else {
+            *tail = r;
+        }
+    }
+    disorder.longest_sorted = tails.size();
+    disorder.rem = n - tails.size();
+
+    // below[i] counts the elements less than element i, up_to[i] the ones no bigger, found by walking the sorted order
+    // one group of equal values at a time. the elements strictly between two values are then up_to[low] to below[high]
+    std::vector<std::size_t> below(n);
+    std::vector<std::size_t> up_to(n);
+    for (std::size_t group = 0; group < n;) {
+        std::size_t group_end = group + 1;
+        while (group_end < n && !(*(first + order[group]) < *(first + order[group_end]))) {++group_end;}
+        for (std::size_t k = group; k < group_end; ++k) {
+            below[order[k]] = group;
+            up_to[order[k]] = group_end;
+        }
+        group = group_end;
+    }
+    for (std::size_t i = 1; i < n; ++i) {
+        const bool descent = *(first + i) < *(first + i - 1);
+        const std::size_t low = descent ? i : i - 1;
+        const std::size_t high = descent ? i - 1 : i;
+        if (below[high] > up_to[low]) {
+            disorder.osc += below[high] - up_to[low];
+        }
+    }
+
+    // merge sort the ranks bottom up. every rank taken from the right run jumps the ones left in the left run
+    std::vector<std::size_t> buffer(n);
+    for (std::size_t width = 1; width < n; width *= 2) {
+        for (std::size_t left = 0; left < n; left += 2 * width) {
+            const std::size_t middle = std::min(left + width, n);
+            const std::size_t right = std::min(left + 2 * width, n);
+            std::size_t i = left;
+            std::size_t j = middle;
+            std::size_t out = left;
+            while (i < middle && j < right) {
+                if (rank[j] < rank[i]) {
+                    disorder.inversions += middle - i;
+                    buffer[out++] = rank[j++];
+                }
+                else {
+                    buffer[out++] = rank[i++];
+                }
+            }
+            std::copy(rank.begin() + i, rank.begin() + middle, buffer.begin() + out);
+            std::copy(rank.begin() + j, rank.begin() + right, buffer.begin() + out + (middle - i));
+        }
+        rank.swap(buffer);
+    }
+
+    return disorder;
+}
+
+
+template <class RandomIt>
+SortDecision smart_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, std::ostream* log) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    constexpr std::size_t samples = 512;
+    const std::size_t n = last - first;
+
+    SortDecision decision;
+    decision.size = n;
+    decision.element_size = sizeof(T);
+
+    auto pick = [&](const char* algorithm, const char* reason) {
+        decision.algorithm = algorithm;
+        decision.reason = reason;
+        if (log != nullptr) {
+            *log << "smart_sort: " << decision << std::endl;
+        }
+    };
+
+    if (n <= 32) {
+        pick("insertion sort", "tiny");
+        insertion_sort(first, last, shader, window);
+        return decision;
+    }
+
+    // same positions for the same size every time, so a decision can be reproduced
+    std::mt19937_64 rng{n};
+    std::size_t descents = 0;
+    std::size_t ascents = 0;
+    std::size_t inversions = 0;
+    for (std::size_t i = 0; i < samples; ++i) {
+        const std::size_t at = rng() % (n - 1);
+        descents += *(first + at + 1) < *(first + at);
+        ascents += *(first + at) < *(first + at + 1);
+
+        std::size_t a = rng() % n;
+        std::size_t b = rng() % n;
+        if (b < a) {std::swap(a, b);}
+        inversions += *(first + b) < *(first + a);
+    }
+    // natural_merge_sort reverses strictly descending runs, so a run can go either way
+    decision.run_rate = static_cast<double>(std::min(descents, ascents)) / samples;
+    decision.inversion_rate = static_cast<double>(inversions) / samples;
+
+    std::vector<T> sample;
+    sample.reserve(samples);
+    for (std::size_t i = 0; i < samples; ++i) {sample.push_back(*(first + rng() % n));}
+    std::sort(sample.begin(), sample.end());
+    std::size_t duplicates = 0;
+    for (std::size_t i = 1; i < samples; ++i) {duplicates += !(sample[i - 1] < sample[i]);}
+    decision.duplicate_rate = static_cast<double>(duplicates) / (samples - 1);
+
+    // runs averaging 64 or more elements, about as long as the runs merge_sort starts from. checked before scanning
+    // for the key range, since natural_merge_sort on sorted input is barely more than that scan
+    if (decision.run_rate <= 1.0 / 64) {
+        pick("natural merge sort", "long runs");
+        natural_merge_sort(first, last, shader, window);
+        return decision;
+    }
+
+    // no more counters than elements, like integer_sort
+    if constexpr (std::is_integral<T>::value && !std::is_same<T, bool>::value) {
+        const auto bounds = std::minmax_element(first, last);
+        decision.key_range = static_cast<double>(radix_key(*bounds.second) - radix_key(*bounds.first));
+        if (decision.key_range < static_cast<double>(n)) {
+            pick("counting sort", "dense integers");
+            counting_sort(first, last, shader, window, *bounds.first, *bounds.second);
+            return decision;
+        }
+    }
+
+    // partitioning a vector at a time beats four radix passes on ints
+    if constexpr (std::is_same<T, int32_t>::value) {
+        pick("simd quicksort", "ints");
+        simd_quicksort(first, last, shader, window);
+        return decision;
+    }
+    else {
+        // radix sorts count and scatter 256 buckets a pass, too much overhead for small arrays
+        if constexpr (has_radix_key<T>) {
+            if (n >= 1024) {
+                pick("radix sort", "numbers");
+                radix_sort(first, last, shader, window);
+                return decision;
+            }
+        }
+
+        // reading a byte at a time skips the prefixes strings share, which every compare would read again
+        if constexpr (std::is_same<T, std::string>::value) {
+            pick("msd string sort", "strings");
+            msd_string_sort(first, last, shader, window);
+            return decision;
+        }
+
+        // quicksort swaps its elements all over the array, merges copy them front to back. a lomuto partition puts
+        // every copy of the pivot on the same side, so heavy duplicates make lopsided partitions
+        if (sizeof(T) > 64 || decision.duplicate_rate >= 0.5) {
+            pick("merge sort", sizeof(T) > 64 ? "big elements" : "many duplicates");
+            merge_sort(first, last, shader, window);
+            return decision;
+        }
+
+        pick("introsort", "no structure found");
+        int depth_limit = 0;
+        for (auto size = n; size > 1; size >>= 1) {depth_limit += 2;}
+        partial_quicksort(first, last, last, depth_limit, shader, window, first, last);
+        return decision;
+    }
+}
+
+
+template <class T>
+template <class InputIt>
+void SortedRuns<T>::insert(InputIt first, InputIt last, const Shader* shader, GLFWwindow* window) {
+    const std::size_t run_first = values.size();
+    values.insert(values.end(), first, last);
+    if (values.size() == run_first) {
+        return;
+    }
+
+    // the sorts only see part of the array, so they don't draw it themselves
+    merge_sort(values.begin() + run_first, values.end(), shader, nullptr);
+    bounds.push_back(values.size());
+    draw_array(values.begin(), values.end(), shader, window);
+
+    // runs end up at least twice the size of the run after them
+    while (bounds.size() > 2) {
+        const std::size_t r = bounds.size() - 3;    // the run before the last
+        const std::size_t before = bounds[r + 1] - bounds[r];
+        const std::size_t newest = bounds[r + 2] - bounds[r + 1];
+        if (before > 2 * newest) {
+            break;
+        }
+
+        kway_merge(values.begin() + bounds[r], values.end(), {0, before, before + newest}, shader, nullptr);
+        bounds.erase(bounds.end() - 2);
+        draw_array(values.begin(), values.end(), shader, window);
+    }
+}
+
+
+template <class T>
+std::size_t SortedRuns<T>::rank(const T& value) const {
+    std::size_t count = 0;
+    for (std::size_t r = 0; r + 1 < bounds.size(); ++r) {
+        count += std::lower_bound(values.begin() + bounds[r], values.begin() + bounds[r + 1], value) - (values.begin() + bounds[r]);
+    }
+    return count;
+}
+
+
+template <class T>
+bool SortedRuns<T>::contains(const T& value) const {
+    for (std::size_t r = 0; r + 1 < bounds.size(); ++r) {
+        if (std::binary_search(values.begin() + bounds[r], values.begin() + bounds[r + 1], value)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+template <class T>
+const std::vector<T>& SortedRuns<T>::sorted(const Shader* shader, GLFWwindow* window) {
+    if (bounds.size() > 2) {
+        kway_merge(values.begin(), values.end(), bounds, shader, window);
+        bounds = {0, values.size()};
+    }
+    return values;
+}
+
+
+template <class T>
+auto stable_radix_key(T value) {
+    if constexpr (std::is_floating_point<T>::value) {
+        if (value == T{}) {value = T{};}
+    }
+    return radix_key(value);
+}
+
+template <class T>
+auto radix_key(T value) {
+    static_assert(std::is_arithmetic<T>::value, "radix sort only works on integers and floats");
+    static_assert(sizeof(T) <= 8, "radix keys are at most 64 bits, so long double has none");
+
+    if constexpr (std::is_floating_point<T>::value) {
+        using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        const Bits sign = Bits{1} << (sizeof(T) * 8 - 1);
+
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(T));
+
+        // negative floats sort backwards by their bits, so flip all of them
+        return (bits & sign) ? static_cast<Bits>(~bits) : static_cast<Bits>(bits | sign);
+    }
+    else {
+        using Bits = std::make_unsigned_t<T>;
+        auto bits = static_cast<Bits>(value);
+
+        // move negative numbers below positive ones
+        if constexpr (std::is_signed<T>::value) {
+            bits = static_cast<Bits>(bits ^ (Bits{1} << (sizeof(T) * 8 - 1)));
+        }
+        return bits;
+    }
+}
+
+template <class RandomIt>
+void radix_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    using Key = decltype(radix_key(std::declval<T>()));
+
+    const std::size_t n = last - first;
+    if (n < 2) {return;}
+
+    // 8 bit digits cover small keys exactly, 11 bit digits save passes on wide keys and the counts still fit in L1
+    constexpr int digit_bits = sizeof(Key) >= 4 ? 11 : 8;
+    constexpr int buckets = 1 << digit_bits;
+    constexpr int passes = (sizeof(Key) * 8 + digit_bits - 1) / digit_bits;
+    constexpr Key mask = buckets - 1;
+
+    // histogram every digit at once so the array is only read one extra time
+    std::vector<std::size_t> counts(passes * buckets, 0);
+    for (auto i = first; i != last; ++i) {
+        const Key key = radix_key(*i);
+        for (int pass = 0; pass < passes; ++pass) {
+            ++counts[pass * buckets + ((key >> (pass * digit_bits)) & mask)];
+        }
+    }
+
+    // scratch space to scatter into, left uninitialized since every slot is written
+    std::unique_ptr<T[]> buffer(new T[n]);
+
+    // stable scatter of one digit, offsets[digit] is where the next key with that digit goes
+    auto scatter = [&](auto from, auto from_last, auto to, std::size_t* offsets, int shift) {
+        for (auto i = from; i != from_last; ++i) {
+            *(to + offsets[(radix_key(*i) >> shift) & mask]++) = *i;
+            draw_array(to, to + n, shader, window);
+        }
+    };
+
+    bool in_buffer = false;   // track which side holds the most recent pass
+    for (int pass = 0; pass < passes; ++pass) {
+        std::size_t* offsets = &counts[pass * buckets];
+        const int shift = pass * digit_bits;
+
+        // every key has the same digit here, so the pass would not move anything
+        if (offsets[(radix_key(*first) >> shift) & mask] == n) {continue;}
+
+        // turn counts into starting positions
+        std::size_t sum = 0;
+        for (int digit = 0; digit < buckets; ++digit) {
+            const std::size_t count = offsets[digit];
+            offsets[digit] = sum;
+            sum += count;
+        }
+
+        if (in_buffer) {
+            scatter(buffer.get(), buffer.get() + n, first, offsets, shift);
+        }
+        else {
+            scatter(first, last, buffer.get(), offsets, shift);
+        }
+        in_buffer = !in_buffer;
+    }
+
+    // odd number of passes leaves the result in the buffer
+    if (in_buffer) {
+        for (std::size_t i = 0; i < n; ++i) {
+            *(first + i) = buffer[i];
+            draw_array(first, last, shader, window);
+        }
+    }
+}
+
+
+
+// sort one bucket on the digit at shift, then recurse into the buckets it makes
+template <class RandomIt>
+void msd_radix_sort(RandomIt first, RandomIt last, int shift, const Shader* shader, GLFWwindow* window, RandomIt OG_first, RandomIt OG_last) {
+    constexpr int buckets = 256;
+    constexpr std::ptrdiff_t network_threshold = 32;   // below this, counting costs more than comparing
+
+    auto digit = [shift](const auto& value) {return static_cast<int>((radix_key(value) >> shift) & (buckets - 1));};
+
+    std::ptrdiff_t counts[buckets] = {};
+    for (auto i = first; i != last; ++i) {
+        ++counts[digit(*i)];
+    }
+
+    // next[b] is the first slot of bucket b not yet holding a bucket b element, end[b] is one past the bucket
+    std::ptrdiff_t next[buckets];
+    std::ptrdiff_t end[buckets];
+    std::ptrdiff_t sum = 0;
+    for (int b = 0; b < buckets; ++b) {
+        next[b] = sum;
+        sum += counts[b];
+        end[b] = sum;
+    }
+
+    // every element has the same digit, nothing to move on this one
+    if (counts[digit(*first)] == last - first) {
+        if (shift > 0) {
+            msd_radix_sort(first, last, shift - 8, shader, window, OG_first, OG_last);
+        }
+        return;
+    }
+
+    // follow each displaced element's cycle, swapping it into its bucket until one belongs here
+    for (int b = 0; b < buckets; ++b) {
+        while (next[b] < end[b]) {
+            auto value = *(first + next[b]);
+            int d = digit(value);
+            while (d != b) {
+                std::swap(value, *(first + next[d]++));
+                draw_array(OG_first, OG_last, shader, window);
+                d = digit(value);
+            }
+            *(first + next[b]++) = value;
+            draw_array(OG_first, OG_last, shader, window);
+        }
+    }
+
+    if (shift == 0) {return;}   // last digit, buckets are sorted
+
+    auto bucket_first = first;
+    for (int b = 0; b < buckets; ++b) {
+        auto bucket_last = first + end[b];
+        if (bucket_last - bucket_first > network_threshold) {
+            msd_radix_sort(bucket_first, bucket_last, shift - 8, shader, window, OG_first, OG_last);
+        }
+        else if (bucket_last - bucket_first > 1) {
+            // network sort would only draw the bucket, so draw the whole array once it is done
+            network_sort(bucket_first, bucket_last, shader, nullptr);
+            draw_array(OG_first, OG_last, shader, window);
+        }
+        bucket_first = bucket_last;
+    }
+}
+
+template <class RandomIt>
+void msd_radix_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    using Key = decltype(radix_key(*first));
+
+    if (last - first < 2) {return;}
+
+    // start at the top byte of the key
+    msd_radix_sort(first, last, static_cast<int>(sizeof(Key) * 8 - 8), shader, window, first, last);
+}
+
+
+template <class Func>
+void run_threads(unsigned count, const Func& task) {
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+
+    for (unsigned t = 0; t < count; ++t) {
+        threads.emplace_back([&task, t](){task(t);});
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+inline void stream_line(void* dest, const void* src) {
+#if defined(__SSE2__)
+    auto* out = static_cast<__m128i*>(dest);
+    const auto* in = static_cast<const __m128i*>(src);
+    for (int i = 0; i < 4; ++i) {
+        _mm_stream_si128(out + i, _mm_loadu_si128(in + i));
+    }
+#else
+    std::memcpy(dest, src, 64);
+#endif
+}
+
+inline void stream_fence() {
+#if defined(__SSE2__)
+    _mm_sfence();
+#endif
+}
+
+template <class RandomIt>
+void parallel_radix_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, bool streaming_stores) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    using Key = decltype(radix_key(std::declval<T>()));
+
+    const std::size_t n = last - first;
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // streamed lines are aligned by address, which only works in flat storage
+    streaming_stores = streaming_stores && is_contiguous_iterator<RandomIt>;
+
+    // starting threads costs more than sorting a small array, and one thread is faster with radix_sort's wider digits
+    // unless streaming stores were asked for
+    if (n < (1u << 16) || (threads == 1 && !streaming_stores)) {
+        radix_sort(first, last, shader, window);
+        return;
+    }
+
+    // 8 bit digits keep every thread's write buffers in L1
+    constexpr int digit_bits = 8;
+    constexpr int buckets = 1 << digit_bits;
+    constexpr int passes = sizeof(Key);
+    constexpr std::size_t line = sizeof(T) < 64 ? 64 / sizeof(T) : 1;   // elements per cache line
+
+    std::unique_ptr<T[]> buffer(new T[n]);
+    std::vector<std::size_t> counts(threads * buckets);   // counts[t * buckets + digit] for thread t's slice
+
+    auto slice_first = [n, threads](unsigned t) {return n * t / threads;};
+
+    // scatter from into to on the digit at shift, return false if the pass was skipped
+    auto pass = [&](auto from, auto to, int shift) {
+        auto digit = [shift](const T& value) {return static_cast<int>((radix_key(value) >> shift) & (buckets - 1));};
+
+        run_threads(threads, [&](unsigned t) {
+            std::size_t* count = &counts[t * buckets];
+            std::fill(count, count + buckets, 0);
+            for (std::size_t i = slice_first(t); i < slice_first(t + 1); ++i) {
+                ++count[digit(*(from + i))];
+            }
+        });
+
+        // every key has the same digit here, so the pass would not move anything
+        const int first_digit = digit(*from);
+        std::size_t shared = 0;
+        for (unsigned t = 0; t < threads; ++t) {
+            shared += counts[t * buckets + first_digit];
+        }
+        if (shared == n) {return false;}
+
+        run_threads(threads, [&](unsigned t) {
+            // prefix sum for this thread's column: keys in smaller buckets, then this bucket's keys from earlier slices
+            std::size_t offsets[buckets];
+            std::size_t sum = 0;
+            for (int b = 0; b < buckets; ++b) {
+                for (unsigned other = 0; other < threads; ++other) {
+                    if (other == t) {offsets[b] = sum;}
+                    sum += counts[other * buckets + b];
+                }
+            }
+
+            // software write combining, stage a cache line per bucket and write it out in one go
+            std::unique_ptr<T[]> staged(new T[buckets * line]);
+            std::size_t filled[buckets] = {};
+            std::size_t limit[buckets];   // elements to stage before flushing
+
+            // streamed lines must be aligned, so the first flush of each bucket only fills up to a line boundary
+            for (int b = 0; b < buckets; ++b) {
+                const auto address = reinterpret_cast<std::uintptr_t>(&*to + offsets[b]);
+                limit[b] = (streaming_stores && address % 64 != 0) ? (64 - address % 64) / sizeof(T) : line;
+                if (limit[b] == 0) {limit[b] = line;}
+            }
+
+            for (std::size_t i = slice_first(t); i < slice_first(t + 1); ++i) {
+                const T value = *(from + i);
+                const int b = digit(value);
+                staged[b * line + filled[b]++] = value;
+
+                if (filled[b] == limit[b]) {
+                    if (streaming_stores && filled[b] * sizeof(T) == 64) {
+                        stream_line(&*to + offsets[b], &staged[b * line]);
+                    }
+                    else {
+                        std::copy(&staged[b * line], &staged[b * line] + filled[b], to + offsets[b]);
+                    }
+                    offsets[b] += filled[b];
+                    filled[b] = 0;
+                    limit[b] = line;
+                }
+            }
+
+            // flush partly filled lines
+            for (int b = 0; b < buckets; ++b) {
+                std::copy(&staged[b * line], &staged[b * line] + filled[b], to + offsets[b]);
+            }
+            if (streaming_stores) {stream_fence();}
+        });
+
+        draw_array(to, to + n, shader, window);
+        return true;
+    };
+
+    bool in_buffer = false;   // track which side holds the most recent pass
+    for (int p = 0; p < passes; ++p) {
+        const bool moved = in_buffer ? pass(buffer.get(), first, p * digit_bits) : pass(first, buffer.get(), p * digit_bits);
+        if (moved) {in_buffer = !in_buffer;}
+    }
+
+    // odd number of passes leaves the result in the buffer
+    if (in_buffer) {
+        run_threads(threads, [&](unsigned t) {
+            std::copy(buffer.get() + slice_first(t), buffer.get() + slice_first(t + 1), first + slice_first(t));
+        });
+        draw_array(first, last, shader, window);
+    }
+}
+
+
+template <class RandomIt, class T>
+void counting_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, T min_key, T max_key) {
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+    using Bits = std::make_unsigned_t<Value>;
+    static_assert(std::is_integral<Value>::value, "counting sort only works on integers");
+
+    if (last - first < 2) {return;}
+
+    const auto min_value = static_cast<Value>(min_key);
+    if (!counting_range_fits(min_value, static_cast<Value>(max_key), static_cast<std::size_t>(last - first))) {
+        radix_sort(first, last, shader, window);
+        return;
+    }
+
+    // radix keys keep their order and never overflow when subtracted, even from the most negative value
+    const auto base = radix_key(min_value);
+    std::vector<std::size_t> counts(static_cast<std::size_t>(radix_key(static_cast<Value>(max_key)) - base) + 1, 0);
+
+    for (auto i = first; i != last; ++i) {
+        ++counts[radix_key(*i) - base];
+    }
+
+    // write each value back as many times as it was seen
+    auto current = first;
+    for (std::size_t offset = 0; offset < counts.size(); ++offset) {
+        const auto value = static_cast<Value>(static_cast<Bits>(min_value) + static_cast<Bits>(offset));
+        for (std::size_t count = counts[offset]; count > 0; --count) {
+            *current = value;
+            ++current;
+            draw_array(first, last, shader, window);
+        }
+    }
+}
+
+template <class RandomIt>
+void counting_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    if (last - first < 2) {return;}
+
+    const auto bounds = std::minmax_element(first, last);
+    counting_sort(first, last, shader, window, *bounds.first, *bounds.second);
+}
+
+template <class KeyIt, class ValueIt>
+void counting_sort_by_key(KeyIt keys_first, KeyIt keys_last, ValueIt values_first, const Shader* shader, GLFWwindow* window) {
+    using Key = typename std::iterator_traits<KeyIt>::value_type;
+    using Value = typename std::iterator_traits<ValueIt>::value_type;
+    static_assert(std::is_integral<Key>::value, "counting sort only works on integer keys");
+
+    const std::size_t n = keys_last - keys_first;
+    if (n < 2) {return;}
+
+    const auto bounds = std::minmax_element(keys_first, keys_last);
+    if (!counting_range_fits(*bounds.first, *bounds.second, n)) {
+        // too many values for a counter each, so take the stable order from argsort and move both arrays into it
+        const std::vector<std::size_t> order = argsort(keys_first, keys_last);
+        permute_columns(order.begin(), n, keys_first, values_first);
+        draw_array(keys_first, keys_last, shader, window);
+        return;
+    }
+
+    const auto base = radix_key(*bounds.first);
+    std::vector<std::size_t> offsets(static_cast<std::size_t>(radix_key(*bounds.second) - base) + 1, 0);
+
+    for (auto i = keys_first; i != keys_last; ++i) {
+        ++offsets[radix_key(*i) - base];
+    }
+
+    // turn counts into starting positions
+    std::size_t sum = 0;
+    for (auto& offset : offsets) {
+        const std::size_t count = offset;
+        offset = sum;
+        sum += count;
+    }
+
+    // scatter in input order so equal keys keep their values' order
+    std::vector<Key> sorted_keys(n);
+    std::vector<Value> sorted_values(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t to = offsets[radix_key(*(keys_first + i)) - base]++;
+        sorted_keys[to] = *(keys_first + i);
+        sorted_values[to] = std::move(*(values_first + i));
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        *(keys_first + i) = sorted_keys[i];
+        *(values_first + i) = std::move(sorted_values[i]);
+        draw_array(keys_first, keys_last, shader, window);
+    }
+}
+
+template <class T>
+bool counting_range_fits(T min_key, T max_key, std::size_t n) {
+    const uint64_t range = static_cast<uint64_t>(radix_key(max_key)) - static_cast<uint64_t>(radix_key(min_key));
+    return range / 4 < n && range < std::numeric_limits<std::size_t>::max();
+}
+
+template <class RandomIt>
+void integer_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    const std::size_t n = last - first;
+    if (n < 2) {return;}
+
+    // counting needs a slot per possible value, so only use it when there are no more slots than elements
+    const auto bounds = std::minmax_element(first, last);
+    if (static_cast<std::size_t>(radix_key(*bounds.second) - radix_key(*bounds.first)) < n) {
+        counting_sort(first, last, shader, window, *bounds.first, *bounds.second);
+    }
+    else {
+        radix_sort(first, last, shader, window);
+    }
+}
+
+
+template <class S>
+inline unsigned string_digit(const S& s, std::size_t depth) {
+    return depth < s.size() ? static_cast<unsigned char>(s[depth]) + 1u : 0u;
+}
+
+
+template <class S>
+bool suffix_less(const S& a, const S& b, std::size_t depth) {
+    for (;; ++depth) {
+        const unsigned a_digit = string_digit(a, depth);
+        const unsigned b_digit = string_digit(b, depth);
+        if (a_digit != b_digit) {
+            return a_digit < b_digit;
+        }
+        if (a_digit == 0) {
+            return false;
+        }
+    }
+}
+
+
+template <class RandomIt>
+void multikey_quicksort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    multikey_quicksort(first, last, 0, identity_projection{}, shader, window, first, last);
+}
+
+
+template <class RandomIt, class KeyOf>
+void multikey_quicksort(RandomIt first, RandomIt last, std::size_t depth, const KeyOf& key_of, const Shader* shader, GLFWwindow* window,
+                        RandomIt OG_first, RandomIt OG_last) {
+    auto digit = [&](RandomIt at) {return string_digit(key_of(*at), depth);};
+
+    while (last - first > 1) {
+        // a few strings left, insertion sort on the rest of each string
+        if (last - first < 16) {
+            for (auto index = first + 1; index < last; ++index) {
+                for (auto current = index; current > first && suffix_less(key_of(*current), key_of(*(current - 1)), depth); --current) {
+                    std::iter_swap(current, current - 1);
+                    draw_array(OG_first, OG_last, shader, window);
+                }
+            }
+            return;
+        }
+
+        const unsigned a = digit(first);
+        const unsigned b = digit(first + (last - first) / 2);
+        const unsigned c = digit(last - 1);
+        const unsigned pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+        // [first, less_end) has a smaller byte, [less_end, current) the pivot byte, [greater_first, last) a bigger one
+        auto less_end = first;
+        auto current = first;
+        auto greater_first = last;
+        while (current < greater_first) {
+            const unsigned at = digit(current);
+            if (at < pivot) {
+                std::iter_swap(less_end++, current++);
+            }
+            else if (at > pivot) {
+                std::iter_swap(current, --greater_first);
+            }
+            else {
+                ++current;
+            }
+        }
+        draw_array(OG_first, OG_last, shader, window);
+
+        multikey_quicksort(first, less_end, depth, key_of, shader, window, OG_first, OG_last);
+        multikey_quicksort(greater_first, last, depth, key_of, shader, window, OG_first, OG_last);
+
+        // strings that ended at this depth are all equal
+        if (pivot == 0) {
+            return;
+        }
+        first = less_end;
+        last = greater_first;
+        ++depth;
+    }
+}
+
+
+template <class RandomIt>
+void msd_string_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    const std::size_t n = last - first;
+    if (n < 2) {return;}
+
+    std::unique_ptr<T[]> scratch(new T[n]);
+    std::unique_ptr<uint16_t[]> cache(new uint16_t[n]);
+    msd_string_sort(first, last, 0, scratch.get(), cache.get(), shader, window, first, last);
+}
+
+
+template <class RandomIt, class T>
+void msd_string_sort(RandomIt first, RandomIt last, std::size_t depth, T* scratch, uint16_t* cache, const Shader* shader, GLFWwindow* window,
+                     RandomIt OG_first, RandomIt OG_last) {
+    const std::size_t n = last - first;
+    if (n < 32) {
+        multikey_quicksort(first, last, depth, identity_projection{}, shader, window, OG_first, OG_last);
+        return;
+    }
+
+    std::size_t counts[257];
+    while (true) {
+        std::fill(std::begin(counts), std::end(counts), 0);
+        for (std::size_t i = 0; i < n; ++i) {
+            cache[i] = static_cast<uint16_t>(string_digit(*(first + i), depth));
+            ++counts[cache[i]];
+        }
+
+        // every string has ended, so they are all equal
+        if (counts[0] == n) {
+            return;
+        }
+        if (counts[cache[0]] < n) {
+            break;
+        }
+        ++depth;
+    }
+
+    std::size_t offsets[257];
+    std::size_t offset = 0;
+    for (std::size_t digit = 0; digit < 257; ++digit) {
+        offsets[digit] = offset;
+        offset += counts[digit];
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        scratch[offsets[cache[i]]++] = std::move(*(first + i));
+    }
+    std::move(scratch, scratch + n, first);
+    draw_array(OG_first, OG_last, shader, window);
+
+    // the strings that ended are equal and already first, every other bucket is sorted from the next byte
+    std::size_t bucket_first = counts[0];
+    for (std::size_t digit = 1; digit < 257; ++digit) {
+        if (counts[digit] > 1) {
+            msd_string_sort(first + bucket_first, first + bucket_first + counts[digit], depth + 1, scratch + bucket_first,
+                            cache + bucket_first, shader, window, OG_first, OG_last);
+        }
+        bucket_first += counts[digit];
+    }
+}
+
+
+template <class RandomIt>
+void burstsort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    constexpr std::size_t burst_limit = 8192;   // 64 KB of indices, about what fits in L2 next to the strings' first bytes
+    const std::size_t n = last - first;
+    if (n < 2) {return;}
+
+    // a trie node's slot for each next byte either holds a bucket of indices or points to the node one byte deeper.
+    // slot 0 holds the strings that end at the node and never bursts
+    struct Node {
+        std::array<std::vector<std::size_t>, 257> buckets;
+        std::array<std::size_t, 257> children{};    // 0 for none, the root is never a child
+    };
+    std::vector<Node> nodes(1);
+    auto key_of = [first](std::size_t index) -> decltype(auto) {return *(first + index);};
+
+    // move a bucket into a new node one byte deeper, then burst any of the new buckets that are still too big
+    auto burst = [&](std::size_t node, unsigned digit, std::size_t depth) {
+        std::vector<std::tuple<std::size_t, unsigned, std::size_t>> pending{{node, digit, depth}};
+        while (!pending.empty()) {
+            const auto [parent, parent_digit, parent_depth] = pending.back();
+            pending.pop_back();
+
+            const std::size_t child = nodes.size();
+            nodes.emplace_back();
+            nodes[parent].children[parent_digit] = child;
+            const std::vector<std::size_t> bucket = std::move(nodes[parent].buckets[parent_digit]);
+            nodes[parent].buckets[parent_digit] = {};
+            for (const std::size_t index : bucket) {
+                nodes[child].buckets[string_digit(key_of(index), parent_depth + 1)].push_back(index);
+            }
+            for (unsigned next = 1; next < 257; ++next) {
+                if (nodes[child].buckets[next].size() > burst_limit) {
+                    pending.emplace_back(child, next, parent_depth + 1);
+                }
+            }
+        }
+    };
+
+    for (std::size_t index = 0; index < n; ++index) {
+        std::size_t node = 0;
+        std::size_t depth = 0;
+        unsigned digit = string_digit(key_of(index), depth);
+        while (digit != 0 && nodes[node].children[digit] != 0) {
+            node = nodes[node].children[digit];
+            digit = string_digit(key_of(index), ++depth);
+        }
+
+        auto& bucket = nodes[node].buckets[digit];
+        bucket.push_back(index);
+        if (digit != 0 && bucket.size() > burst_limit) {
+            burst(node, digit, depth);
+        }
+    }
+
+    // walk the trie in byte order, sorting each bucket past the bytes its strings share
+    std::vector<std::size_t> order;
+    order.reserve(n);
+    auto collect = [&](const auto& self, std::size_t node, std::size_t depth) -> void {
+        for (unsigned digit = 0; digit < 257; ++digit) {
+            if (nodes[node].children[digit] != 0) {
+                self(self, nodes[node].children[digit], depth + 1);
+                continue;
+            }
+            const auto& bucket = nodes[node].buckets[digit];
+            const std::size_t bucket_first = order.size();
+            order.insert(order.end(), bucket.begin(), bucket.end());
+            if (digit != 0) {
+                multikey_quicksort(order.begin() + bucket_first, order.end(), depth + 1, key_of, nullptr, nullptr,
+                                   order.begin() + bucket_first, order.end());
+            }
+        }
+    };
+    collect(collect, 0, 0);
+    nodes.clear();
+
+    apply_permutation(first, last, order.begin(), shader, window);
+}
+
+
+#if defined(SIMD_NETWORKS)
+
+// 32 byte vector of T, 8 ints or floats, 4 int64s
+template <class T>
+struct simd_vector {typedef T type __attribute__((vector_size(32)));};
+
+/// @brief one compare step of a bitonic network over a block held in vectors. strides of a vector or more compare whole
+/// vectors against each other, smaller strides shuffle each lane's partner into place and keep the min or max depending
+/// on its position in the network
+/// @param k the size of the bitonic sequences being merged, sequences with the k bit set are sorted descending
+/// @param j the distance between compared elements
+template <class T, class Lanes>
+__attribute__((always_inline)) inline void bitonic_network_step(T* data, int n, int k, int j, const Lanes& lane) {
+    using Vec = typename simd_vector<T>::type;
+    constexpr int lanes = sizeof(Vec) / sizeof(T);
+
+    if (j >= lanes) {
+        for (int i = 0; i < n; i += lanes) {
+            if (i & j) {continue;}
+
+            Vec low, high;
+            std::memcpy(&low, data + i, sizeof(Vec));
+            std::memcpy(&high, data + i + j, sizeof(Vec));
+            Vec smaller = low < high ? low : high;
+            Vec larger = low < high ? high : low;
+
+            // every other sequence is sorted descending so pairs of them form the next bitonic sequence
+            if (i & k) {std::swap(smaller, larger);}
+
+            std::memcpy(data + i, &smaller, sizeof(Vec));
+            std::memcpy(data + i + j, &larger, sizeof(Vec));
+        }
+    }
+    else {
+        const Lanes partner = lane ^ j;
+        for (int i = 0; i < n; i += lanes) {
+            Vec values;
+            std::memcpy(&values, data + i, sizeof(Vec));
+            const Vec other = __builtin_shuffle(values, partner);
+            const Vec smaller = values < other ? values : other;
+            const Vec larger = values < other ? other : values;
+
+            // the upper element of an ascending pair keeps the max, flipped in descending sequences
+            const Lanes index = lane + i;
+            const Lanes keep_larger = ((index & j) != 0) ^ ((index & k) != 0);
+            const Vec result = keep_larger ? larger : smaller;
+            std::memcpy(data + i, &result, sizeof(Vec));
+        }
+    }
+}
+
+template <class T>
+__attribute__((always_inline)) inline void bitonic_network(T* data, int n) {
+    using Lanes = typename simd_vector<std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>::type;
+    constexpr int lanes = sizeof(Lanes) / sizeof(T);
+
+    Lanes lane;
+    for (int l = 0; l < lanes; ++l) {lane[l] = l;}
+
+    for (int k = 2; k <= n; k <<= 1) {
+        for (int j = k >> 1; j > 0; j >>= 1) {
+            bitonic_network_step(data, n, k, j, lane);
+        }
+    }
+}
+
+/// @brief the last merge of bitonic_network on its own, sorts a block that is already bitonic
+template <class T>
+__attribute__((always_inline)) inline void bitonic_clean_network(T* data, int n) {
+    using Lanes = typename simd_vector<std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>::type;
+    constexpr int lanes = sizeof(Lanes) / sizeof(T);
+
+    Lanes lane;
+    for (int l = 0; l < lanes; ++l) {lane[l] = l;}
+
+    // k past the end of the block keeps every pair ascending
+    for (int j = n >> 1; j > 0; j >>= 1) {
+        bitonic_network_step(data, n, 2 * n, j, lane);
+    }
+}
+
+SIMD_CLONES void sorting_network(int32_t* data, int n) {bitonic_network(data, n);}
+SIMD_CLONES void sorting_network(float* data, int n) {bitonic_network(data, n);}
+SIMD_CLONES void sorting_network(int64_t* data, int n) {bitonic_network(data, n);}
+
+SIMD_CLONES void bitonic_clean(int32_t* data, int n) {bitonic_clean_network(data, n);}
+SIMD_CLONES void bitonic_clean(float* data, int n) {bitonic_clean_network(data, n);}
+SIMD_CLONES void bitonic_clean(int64_t* data, int n) {bitonic_clean_network(data, n);}
+
+/// @brief merge two sorted vectors. low becomes the smallest half, high the largest, both sorted
+template <class Vec, class Lanes>
+__attribute__((always_inline)) inline void merge_vectors(Vec& low, Vec& high, const Lanes& lane) {
+    constexpr int lanes = sizeof(Lanes) / sizeof(lane[0]);
+
+    // an ascending vector next to a descending one is bitonic, so one compare splits it into lower and upper halves
+    const Vec flipped = __builtin_shuffle(high, (lanes - 1) - lane);
+    Vec smaller = low < flipped ? low : flipped;
+    Vec larger = low < flipped ? flipped : low;
+
+    // each half is still bitonic, finish sorting it inside the vector
+    for (int j = lanes / 2; j > 0; j >>= 1) {
+        const Lanes partner = lane ^ j;
+        const Lanes keep_larger = (lane & j) != 0;
+
+        const Vec smaller_other = __builtin_shuffle(smaller, partner);
+        const Vec larger_other = __builtin_shuffle(larger, partner);
+        smaller = keep_larger ? (smaller < smaller_other ? smaller_other : smaller) : (smaller < smaller_other ? smaller : smaller_other);
+        larger = keep_larger ? (larger < larger_other ? larger_other : larger) : (larger < larger_other ? larger : larger_other);
+    }
+
+    low = smaller;
+    high = larger;
+}
+
+template <class T>
+__attribute__((always_inline)) inline void bitonic_merge(const T* a, std::size_t a_count, const T* b, std::size_t b_count, T* out) {
+    using Vec = typename simd_vector<T>::type;
+    using Lanes = typename simd_vector<std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>::type;
+    constexpr std::size_t lanes = sizeof(Vec) / sizeof(T);
+
+    if (a_count < lanes || b_count < lanes) {
+        std::merge(a, a + a_count, b, b + b_count, out);
+        return;
+    }
+
+    Lanes lane;
+    for (std::size_t l = 0; l < lanes; ++l) {lane[l] = l;}
+
+    const T* a_end = a + a_count;
+    const T* b_end = b + b_count;
+
+    Vec low, high;
+    std::memcpy(&low, a, sizeof(Vec));
+    std::memcpy(&high, b, sizeof(Vec));
+    a += lanes;
+    b += lanes;
+
+    for (;;) {
+        merge_vectors(low, high, lane);
+        std::memcpy(out, &low, sizeof(Vec));
+        out += lanes;
+
+        // the run with the smaller next number has to supply the next vector, stop once it has less than a vector left
+        const T*& next = (a == a_end || (b != b_end && *b < *a)) ? b : a;
+        const T* next_end = (next == a) ? a_end : b_end;
+        if (static_cast<std::size_t>(next_end - next) < lanes) {break;}
+
+        low = high;
+        std::memcpy(&high, next, sizeof(Vec));
+        next += lanes;
+    }
+
+    // merge what is left of the high vector with the short run, then that with the other run
+    T carried[lanes];
+    std::memcpy(carried, &high, sizeof(Vec));
+
+    const bool a_short = static_cast<std::size_t>(a_end - a) < lanes;
+    const T* short_first = a_short ? a : b;
+    const T* short_last = a_short ? a_end : b_end;
+
+    T staged[2 * lanes];
+    T* staged_end = std::merge(carried, carried + lanes, short_first, short_last, staged);
+    std::merge(staged, staged_end, a_short ? b : a, a_short ? b_end : a_end, out);
+}
+
+SIMD_CLONES void simd_merge(const int32_t* a, std::size_t a_count, const int32_t* b, std::size_t b_count, int32_t* out) {bitonic_merge(a, a_count, b, b_count, out);}
+SIMD_CLONES void simd_merge(const float* a, std::size_t a_count, const float* b, std::size_t b_count, float* out) {bitonic_merge(a, a_count, b, b_count, out);}
+SIMD_CLONES void simd_merge(const int64_t* a, std::size_t a_count, const int64_t* b, std::size_t b_count, int64_t* out) {bitonic_merge(a, a_count, b, b_count, out);}
+
+// load two vectors of neighbouring pairs, shuffle the first of each pair into one vector and the second into another,
+// keep the min and max of the two and shuffle them back into pairs
+template <class T>
+__attribute__((always_inline)) inline std::size_t odd_even_network(T* data, std::size_t pairs) {
+    using Vec = typename simd_vector<T>::type;
+    using Lanes = typename simd_vector<std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>::type;
+    constexpr int lanes = sizeof(Vec) / sizeof(T);
+
+    Lanes lane;
+    for (int l = 0; l < lanes; ++l) {lane[l] = l;}
+    const Lanes firsts = lane * 2;
+    const Lanes seconds = lane * 2 + 1;
+    const Lanes low_pairs = lane / 2 + (lane & 1) * lanes;
+    const Lanes high_pairs = low_pairs + lanes / 2;
+
+    Lanes swapped = lane - lane;    // -1 per swap
+    std::size_t i = 0;
+    for (; i + lanes <= pairs; i += lanes) {
+        Vec a, b;
+        std::memcpy(&a, data + 2 * i, sizeof(Vec));
+        std::memcpy(&b, data + 2 * i + lanes, sizeof(Vec));
+
+        const Vec left = __builtin_shuffle(a, b, firsts);
+        const Vec right = __builtin_shuffle(a, b, seconds);
+        const Lanes out_of_order = right < left;
+        const Vec smaller = out_of_order ? right : left;
+        const Vec larger = out_of_order ? left : right;
+        swapped += out_of_order;
+
+        a = __builtin_shuffle(smaller, larger, low_pairs);
+        b = __builtin_shuffle(smaller, larger, high_pairs);
+        std::memcpy(data + 2 * i, &a, sizeof(Vec));
+        std::memcpy(data + 2 * i + lanes, &b, sizeof(Vec));
+    }
+
+    std::size_t swaps = 0;
+    for (int l = 0; l < lanes; ++l) {swaps -= swapped[l];}
+    return swaps + odd_even_exchange<T>(data + 2 * i, pairs - i);
+}
+
+SIMD_CLONES std::size_t odd_even_exchange(int32_t* data, std::size_t pairs) {return odd_even_network(data, pairs);}
+SIMD_CLONES std::size_t odd_even_exchange(float* data, std::size_t pairs) {return odd_even_network(data, pairs);}
+SIMD_CLONES std::size_t odd_even_exchange(int64_t* data, std::size_t pairs) {return odd_even_network(data, pairs);}
+
+#else
+
+// no vector extensions, the same network one compare at a time
+template <class T>
+void bitonic_network(T* data, int n) {
+    for (int k = 2; k <= n; k <<= 1) {
+        for (int j = k >> 1; j > 0; j >>= 1) {
+            for (int i = 0; i < n; ++i) {
+                const int partner = i ^ j;
+                if (partner > i && ((data[i] > data[partner]) == ((i & k) == 0))) {
+                    std::swap(data[i], data[partner]);
+                }
+            }
+        }
+    }
+}
+
+void sorting_network(int32_t* data, int n) {bitonic_network(data, n);}
+void sorting_network(float* data, int n) {bitonic_network(data, n);}
+void sorting_network(int64_t* data, int n) {bitonic_network(data, n);}
+
+// the last merge on its own, with every pair ascending
+template <class T>
+void bitonic_clean_network(T* data, int n) {
+    for (int j = n >> 1; j > 0; j >>= 1) {
+        for (int i = 0; i < n; ++i) {
+            if (!(i & j) && data[i + j] < data[i]) {
+                std::swap(data[i], data[i + j]);
+            }
+        }
+    }
+}
+
+void bitonic_clean(int32_t* data, int n) {bitonic_clean_network(data, n);}
+void bitonic_clean(float* data, int n) {bitonic_clean_network(data, n);}
+void bitonic_clean(int64_t* data, int n) {bitonic_clean_network(data, n);}
+
+void simd_merge(const int32_t* a, std::size_t a_count, const int32_t* b, std::size_t b_count, int32_t* out) {std::merge(a, a + a_count, b, b + b_count, out);}
+void simd_merge(const float* a, std::size_t a_count, const float* b, std::size_t b_count, float* out) {std::merge(a, a + a_count, b, b + b_count, out);}
+void simd_merge(const int64_t* a, std::size_t a_count, const int64_t* b, std::size_t b_count, int64_t* out) {std::merge(a, a + a_count, b, b + b_count, out);}
+
+std::size_t odd_even_exchange(int32_t* data, std::size_t pairs) {return odd_even_exchange<int32_t>(data, pairs);}
+std::size_t odd_even_exchange(float* data, std::size_t pairs) {return odd_even_exchange<float>(data, pairs);}
+std::size_t odd_even_exchange(int64_t* data, std::size_t pairs) {return odd_even_exchange<int64_t>(data, pairs);}
+
+#endif
+
+template <class RandomIt>
+void network_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    constexpr bool has_network = std::is_same<T, int32_t>::value || std::is_same<T, float>::value || std::is_same<T, int64_t>::value;
+
+    const int n = static_cast<int>(last - first);
+    if (n < 2) {return;}
+
+    if constexpr (has_network) {
+        if (n <= 64) {
+            // pad up to a network size with values that sort after everything
+            int block = 8;
+            while (block < n) {block <<= 1;}
+
+            T padded[64];
+            std::copy(first, last, padded);
+            std::fill(padded + n, padded + block, std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max());
+
+            sorting_network(padded, block);
+
+            std::copy(padded, padded + n, first);
+            draw_array(first, last, shader, window);
+            return;
+        }
+    }
+
+    binary_insertion_sort(first, last, shader, window);
+}
+
+
+#if defined(SIMD_PARTITION)
+
+/// @brief for every 8 bit mask of which lanes are less than the pivot, the lane order that puts those lanes first
+const int32_t (&partition_permutations())[256][8] {
+    alignas(32) static int32_t table[256][8];
+    static const bool built = [](){
+        for (int mask = 0; mask < 256; ++mask) {
+            int next = 0;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (mask & (1 << lane)) {table[mask][next++] = lane;}
+            }
+            for (int lane = 0; lane < 8; ++lane) {
+                if (!(mask & (1 << lane))) {table[mask][next++] = lane;}
+            }
+        }
+        return true;
+    }();
+    static_cast<void>(built);
+    return table;
+}
+
+/// @brief split one vector, smaller keys go to left_write and the rest end at right_write. both get a full vector store,
+/// so each side needs 8 free slots, or the two free areas must be the same 8 slots
+__attribute__((target("avx2,popcnt"), always_inline))
+inline void partition_vector_avx2(__m256i values, __m256i pivots, int32_t*& left_write, int32_t*& right_write) {
+    const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(pivots, values)));
+    const int smaller = __builtin_popcount(mask);
+
+    const __m256i order = _mm256_load_si256(reinterpret_cast<const __m256i*>(partition_permutations()[mask]));
+    const __m256i split = _mm256_permutevar8x32_epi32(values, order);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(left_write), split);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(right_write - 8), split);
+    left_write += smaller;
+    right_write -= 8 - smaller;
+}
+
+/// @brief split one vector with compress stores, which only write the lanes that are kept
+__attribute__((target("avx512f,popcnt"), always_inline))
+inline void partition_vector_avx512(__m512i values, __m512i pivots, int32_t*& left_write, int32_t*& right_write) {
+    const __mmask16 mask = _mm512_cmplt_epi32_mask(values, pivots);
+    const int smaller = __builtin_popcount(mask);
+
+    _mm512_mask_compressstoreu_epi32(left_write, mask, values);
+    _mm512_mask_compressstoreu_epi32(right_write - (16 - smaller), static_cast<__mmask16>(~mask), values);
+    left_write += smaller;
+    right_write -= 16 - smaller;
+}
+
+/// @brief split the few leftover numbers between the read pointers one at a time
+inline void partition_leftovers(int32_t* read, int32_t* read_end, int32_t pivot, int32_t*& left_write, int32_t*& right_write) {
+    // copy out first, the writes can land on top of them
+    int32_t leftovers[16];
+    const auto count = read_end - read;
+    std::copy(read, read_end, leftovers);
+
+    for (int i = 0; i < count; ++i) {
+        if (leftovers[i] < pivot) {*left_write++ = leftovers[i];}
+        else {*--right_write = leftovers[i];}
+    }
+}
+
+// both kernels hold the first and last vector in registers to open up a vector of free space at each end, then keep
+// reading from whichever end has less free space left so the stores never overwrite numbers that have not been read
+
+__attribute__((target("avx2,popcnt")))
+int32_t* partition_avx2(int32_t* first, int32_t* last, int32_t pivot) {
+    const __m256i pivots = _mm256_set1_epi32(pivot);
+    const __m256i first_vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first));
+    const __m256i last_vector = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last - 8));
+
+    int32_t* left_write = first;
+    int32_t* right_write = last;
+    int32_t* left_read = first + 8;
+    int32_t* right_read = last - 8;
+
+    while (right_read - left_read >= 8) {
+        __m256i values;
+        if (left_read - left_write <= right_write - right_read) {
+            values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left_read));
+            left_read += 8;
+        }
+        else {
+            right_read -= 8;
+            values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right_read));
+        }
+        partition_vector_avx2(values, pivots, left_write, right_write);
+    }
+
+    partition_leftovers(left_read, right_read, pivot, left_write, right_write);
+
+    // 16 free slots left, then exactly the 8 the last vector needs
+    partition_vector_avx2(first_vector, pivots, left_write, right_write);
+    partition_vector_avx2(last_vector, pivots, left_write, right_write);
+    return left_write;
+}
+
+__attribute__((target("avx512f,popcnt")))
+int32_t* partition_avx512(int32_t* first, int32_t* last, int32_t pivot) {
+    const __m512i pivots = _mm512_set1_epi32(pivot);
+    const __m512i first_vector = _mm512_loadu_si512(first);
+    const __m512i last_vector = _mm512_loadu_si512(last - 16);
+
+    int32_t* left_write = first;
+    int32_t* right_write = last;
+    int32_t* left_read = first + 16;
+    int32_t* right_read = last - 16;
+
+    while (right_read - left_read >= 16) {
+        __m512i values;
+        if (left_read - left_write <= right_write - right_read) {
+            values = _mm512_loadu_si512(left_read);
+            left_read += 16;
+        }
+        else {
+            right_read -= 16;
+            values = _mm512_loadu_si512(right_read);
+        }
+        partition_vector_avx512(values, pivots, left_write, right_write);
+    }
+
+    partition_leftovers(left_read, right_read, pivot, left_write, right_write);
+
+    partition_vector_avx512(first_vector, pivots, left_write, right_write);
+    partition_vector_avx512(last_vector, pivots, left_write, right_write);
+    return left_write;
+}
+
+#endif
+
+int32_t* simd_partition(int32_t* first, int32_t* last, int32_t pivot) {
+#if defined(SIMD_PARTITION)
+    // 2 for AVX-512, 1 for AVX2, checked once
+    static const int level = __builtin_cpu_supports("avx512f") ? 2 : (__builtin_cpu_supports("avx2") ? 1 : 0);
+
+    // each kernel needs at least two vectors of input
+    if (level == 2 && last - first >= 32) {return partition_avx512(first, last, pivot);}
+    if (level >= 1 && last - first >= 16) {return partition_avx2(first, last, pivot);}
+#endif
+    return std::partition(first, last, [pivot](int32_t value){return value < pivot;});
+}
+
+void simd_quicksort(int32_t* first, int32_t* last, int depth_limit, const Shader* shader, GLFWwindow* window, int32_t* OG_first, int32_t* OG_last) {
+    while (last - first > 64) {
+        // too many bad pivots, heap sort keeps the worst case at n log n
+        if (depth_limit-- == 0) {
+            std::make_heap(first, last);
+            std::sort_heap(first, last);
+            draw_array(OG_first, OG_last, shader, window);
+            return;
+        }
+
+        // median of three, always one of the numbers in the array
+        const int32_t a = *first;
+        const int32_t b = *(first + (last - first) / 2);
+        const int32_t c = *(last - 1);
+        const int32_t pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+        int32_t* split = simd_partition(first, last, pivot);
+
+        // pivot was the smallest number, so split off everything equal to it instead or it would never shrink
+        if (split == first) {
+            if (pivot == std::numeric_limits<int32_t>::max()) {return;}   // every number is the pivot
+            split = simd_partition(first, last, pivot + 1);
+            draw_array(OG_first, OG_last, shader, window);
+            first = split;
+            continue;
+        }
+        draw_array(OG_first, OG_last, shader, window);
+
+        // recurse on the smaller side and loop on the bigger one to keep the stack shallow
+        if (split - first < last - split) {
+            simd_quicksort(first, split, depth_limit, shader, window, OG_first, OG_last);
+            first = split;
+        }
+        else {
+            simd_quicksort(split, last, depth_limit, shader, window, OG_first, OG_last);
+            last = split;
+        }
+    }
+
+    if (last - first > 1) {
+        network_sort(first, last, shader, nullptr);
+        draw_array(OG_first, OG_last, shader, window);
+    }
+}
+
+template <class RandomIt>
+void simd_quicksort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+
+    if constexpr (std::is_same<T, int32_t>::value && !is_contiguous_iterator<RandomIt>) {
+        sort_flat_copy(first, last, shader, window, [](auto copy_first, auto copy_last, auto* copy_shader, auto* copy_window) {
+            simd_quicksort(copy_first, copy_last, copy_shader, copy_window);
+        });
+    }
+    else if constexpr (std::is_same<T, int32_t>::value) {
+        if (last - first < 2) {return;}
+
+        int depth_limit = 0;
+        for (auto n = last - first; n > 1; n >>= 1) {depth_limit += 2;}
+
+        int32_t* data = &*first;
+        simd_quicksort(data, data + (last - first), depth_limit, shader, window, data, data + (last - first));
+    }
+    else {
+        quicksort(first, last, shader, window, first, last);
+    }
+}
+
+
+template <class T>
+void streamed_merge(const T* a, std::size_t a_count, const T* b, std::size_t b_count, T* out) {
+    constexpr bool vectorized = std::is_same<T, int32_t>::value || std::is_same<T, float>::value || std::is_same<T, int64_t>::value;
+    constexpr std::size_t line = 64 / sizeof(T);
+    constexpr std::size_t chunk = 4096 / sizeof(T);
+    alignas(64) T staged[chunk];
+
+    // how many of the first k merged elements come from a. a[i] comes before b[j - 1] unless b[j - 1] is smaller
+    auto from_a = [&](std::size_t k) {
+        std::size_t low = k > b_count ? k - b_count : 0;
+        std::size_t high = std::min(k, a_count);
+        while (low < high) {
+            const std::size_t i = low + (high - low) / 2;
+            if (!(b[k - i - 1] < a[i])) {low = i + 1;}
+            else {high = i;}
+        }
+        return low;
+    };
+
+    const std::size_t total = a_count + b_count;
+    std::size_t i = 0;
+
+    // the first chunk stops at a line boundary, so every full line after it is aligned
+    const std::size_t misaligned = reinterpret_cast<std::uintptr_t>(out) % 64 / sizeof(T);
+    std::size_t chunk_last = misaligned == 0 ? chunk : line - misaligned;
+    for (std::size_t chunk_first = 0; chunk_first < total; chunk_first = chunk_last, chunk_last += chunk) {
+        chunk_last = std::min(chunk_last, total);
+        const std::size_t next_i = from_a(chunk_last);
+        const T* left = a + i;
+        const T* right = b + (chunk_first - i);
+        const std::size_t left_count = next_i - i;
+        const std::size_t right_count = (chunk_last - next_i) - (chunk_first - i);
+
+        if constexpr (vectorized) {
+            simd_merge(left, left_count, right, right_count, staged);
+        }
+        else {
+            std::merge(left, left + left_count, right, right + right_count, staged);
+        }
+        i = next_i;
+
+        const std::size_t count = chunk_last - chunk_first;
+        std::size_t done = 0;
+        if (reinterpret_cast<std::uintptr_t>(out + chunk_first) % 64 == 0) {
+            for (; done + line <= count; done += line) {
+                stream_line(out + chunk_first + done, staged + done);
+            }
+        }
+        std::copy(staged + done, staged + count, out + chunk_first + done);
+    }
+}
+
+
+template <class RandomIt, class Compare>
+void kway_merge(RandomIt first, RandomIt last, std::vector<std::size_t> bounds, const Shader* shader, GLFWwindow* window,
+                bool streaming_stores, Compare comp) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    constexpr bool natural = is_natural_order<Compare, identity_projection, T>;
+    constexpr bool vectorized = natural && is_contiguous_iterator<RandomIt>
+        && (std::is_same<T, int32_t>::value || std::is_same<T, float>::value || std::is_same<T, int64_t>::value);
+    constexpr bool streamable = natural && is_contiguous_iterator<RandomIt> && std::is_trivial<T>::value && 64 % sizeof(T) == 0;
+
+    const std::size_t n = last - first;
+    if (bounds.size() <= 2) {return;}   // already one run
+
+    std::unique_ptr<T[]> buffer(new T[n]);
+
+    // merge runs 0 and 1, 2 and 3 and so on from one side to the other. an odd run out is copied across
+    auto merge_round = [&](auto from, auto to) {
+        std::vector<std::size_t> merged_bounds{0};
+
+        for (std::size_t r = 0; r + 1 < bounds.size(); r += 2) {
+            const std::size_t run_first = bounds[r];
+            const std::size_t middle = bounds[r + 1];
+            const std::size_t run_last = (r + 2 < bounds.size()) ? bounds[r + 2] : middle;
+
+            if constexpr (streamable) {
+                if (streaming_stores) {
+                    streamed_merge(&*from + run_first, middle - run_first, &*from + middle, run_last - middle, &*to + run_first);
+                    draw_array(to, to + n, shader, window);
+                    merged_bounds.push_back(run_last);
+                    continue;
+                }
+            }
+
+            if constexpr (vectorized) {
+                simd_merge(&*from + run_first, middle - run_first, &*from + middle, run_last - middle, &*to + run_first);
+                draw_array(to, to + n, shader, window);
+            }
+            else {
+                auto left = from + run_first;
+                auto right = from + middle;
+                auto out = to + run_first;
+
+                while (left != from + middle && right != from + run_last) {
+                    *out++ = comp(*right, *left) ? *right++ : *left++;
+                    draw_array(to, to + n, shader, window);
+                }
+                for (; left != from + middle; ++left) {
+                    *out++ = *left;
+                    draw_array(to, to + n, shader, window);
+                }
+                for (; right != from + run_last; ++right) {
+                    *out++ = *right;
+                    draw_array(to, to + n, shader, window);
+                }
+            }
+            merged_bounds.push_back(run_last);
+        }
+        if (streamable && streaming_stores) {stream_fence();}
+
+        bounds = merged_bounds;
+    };
+
+    bool in_buffer = false;   // track which side holds the latest round
+    while (bounds.size() > 2) {
+        if (in_buffer) {
+            merge_round(buffer.get(), first);
+        }
+        else {
+            merge_round(first, buffer.get());
+        }
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer) {
+        for (std::size_t i = 0; i < n; ++i) {
+            *(first + i) = buffer[i];
+            draw_array(first, last, shader, window);
+        }
+    }
+}
+
+template <class RandomIt, class Compare>
+void merge_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window, bool streaming_stores, Compare comp) {
+    constexpr std::size_t block = 64;
+    const std::size_t n = last - first;
+
+    // the sorting networks only know <
+    auto sort_block = [&](RandomIt block_first, RandomIt block_last, GLFWwindow* block_window) {
+        if constexpr (is_natural_order<Compare, identity_projection, typename std::iterator_traits<RandomIt>::value_type>) {
+            network_sort(block_first, block_last, shader, block_window);
+        }
+        else {
+            insertion_sort(block_first, block_last, shader, block_window, comp);
+        }
+    };
+
+    if (n <= block) {
+        sort_block(first, last, window);
+        return;
+    }
+
+    std::vector<std::size_t> bounds;
+    for (std::size_t i = 0; i < n; i += block) {
+        sort_block(first + i, first + std::min(i + block, n), nullptr);
+        bounds.push_back(i);
+    }
+    bounds.push_back(n);
+    draw_array(first, last, shader, window);
+
+    kway_merge(first, last, bounds, shader, window, streaming_stores, comp);
+}
+
+template <class RandomIt>
+void natural_merge_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    constexpr std::size_t min_run = 64;
+    const std::size_t n = last - first;
+    if (n < 2) {return;}
+
+    std::vector<std::size_t> bounds;
+    std::size_t run_first = 0;
+    while (run_first < n) {
+        std::size_t run_last = run_first + 1;
+
+        if (run_last < n && *(first + run_last) < *(first + run_first)) {
+            // strictly descending, so reversing it cannot reorder equal elements
+            while (run_last < n && *(first + run_last) < *(first + run_last - 1)) {++run_last;}
+            std::reverse(first + run_first, first + run_last);
+            draw_array(first, last, shader, window);
+        }
+        else {
+            while (run_last < n && !(*(first + run_last) < *(first + run_last - 1))) {++run_last;}
+        }
+
+        // lots of tiny runs means lots of merge rounds, so grow short ones with network sort
+        if (run_last - run_first < min_run && run_last < n) {
+            run_last = std::min(run_first + min_run, n);
+            network_sort(first + run_first, first + run_last, shader, nullptr);
+            draw_array(first, last, shader, window);
+        }
+
+        bounds.push_back(run_first);
+        run_first = run_last;
+    }
+    bounds.push_back(n);
+
+    kway_merge(first, last, bounds, shader, window);
+}
+
+
+template <class RandomIt>
+void bitonic_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    constexpr bool vectorized = std::is_same<T, int32_t>::value || std::is_same<T, float>::value || std::is_same<T, int64_t>::value;
+    constexpr std::size_t block = 64;
+
+    const std::size_t n = last - first;
+    if (n <= block) {
+        network_sort(first, last, shader, window);
+        return;
+    }
+
+    // copies of the largest element sort to the end, so the first n of the padded array are the answer
+    std::size_t padded_size = block;
+    while (padded_size < n) {padded_size <<= 1;}
+
+    std::unique_ptr<T[]> padded(new T[padded_size]);
+    T* values = padded.get();
+    std::copy(first, last, values);
+    std::fill(values + n, values + padded_size, *std::max_element(first, last));
+
+    // split units of work evenly over the threads and run task(unit_first, unit_last) on each share
+    const unsigned threads = padded_size < (1u << 16) ? 1 : std::max(1u, std::thread::hardware_concurrency());
+    auto in_parallel = [threads](std::size_t units, const auto& task) {
+        if (threads == 1) {
+            task(0, units);
+            return;
+        }
+        run_threads(threads, [&](unsigned t) {task(units * t / threads, units * (t + 1) / threads);});
+    };
+
+    const std::size_t blocks = padded_size / block;
+    const std::size_t pair_units = padded_size / 2 / block;   // compare steps handle a block's worth of pairs at a time
+
+    in_parallel(blocks, [values](std::size_t unit, std::size_t unit_last) {
+        for (; unit < unit_last; ++unit) {
+            if constexpr (vectorized) {sorting_network(values + unit * block, block);}
+            else {binary_insertion_sort(values + unit * block, values + (unit + 1) * block, nullptr, nullptr);}
+        }
+    });
+    draw_array(values, values + padded_size, shader, window);
+
+    // every sequence of k / 2 is sorted ascending, merge them in pairs
+    for (std::size_t k = 2 * block; k <= padded_size; k <<= 1) {
+        // compare each element of the first half with its mirror in the second, which leaves both halves bitonic
+        in_parallel(pair_units, [values, k](std::size_t unit, std::size_t unit_last) {
+            for (; unit < unit_last; ++unit) {
+                const std::size_t pair = unit * block;
+                T* low = values + pair / (k / 2) * k + pair % (k / 2);
+                T* high = values + pair / (k / 2) * k + k - 1 - pair % (k / 2);
+
+                for (std::size_t i = 0; i < block; ++i) {
+                    const T a = low[i];
+                    const T b = *(high - i);
+                    low[i] = std::min(a, b);
+                    *(high - i) = std::max(a, b);
+                }
+            }
+        });
+        draw_array(values, values + padded_size, shader, window);
+
+        // halve the bitonic sequences until they are one block long
+        for (std::size_t j = k / 4; j >= block; j >>= 1) {
+            in_parallel(pair_units, [values, j](std::size_t unit, std::size_t unit_last) {
+                for (; unit < unit_last; ++unit) {
+                    const std::size_t pair = unit * block;
+                    T* low = values + pair / j * 2 * j + pair % j;
+                    T* high = low + j;
+
+                    for (std::size_t i = 0; i < block; ++i) {
+                        const T a = low[i];
+                        const T b = high[i];
+                        low[i] = std::min(a, b);
+                        high[i] = std::max(a, b);
+                    }
+                }
+            });
+            draw_array(values, values + padded_size, shader, window);
+        }
+
+        // each block now holds the right numbers in bitonic order, finish them in registers
+        in_parallel(blocks, [values](std::size_t unit, std::size_t unit_last) {
+            for (; unit < unit_last; ++unit) {
+                if constexpr (vectorized) {bitonic_clean(values + unit * block, block);}
+                else {binary_insertion_sort(values + unit * block, values + (unit + 1) * block, nullptr, nullptr);}
+            }
+        });
+        draw_array(values, values + padded_size, shader, window);
+    }
+
+    std::copy(values, values + n, first);
+    draw_array(first, last, shader, window);
+}
+
+
+template <class RandomIt>
+void sample_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    static_assert(has_radix_key<T>, "sample sort only works on integers and floats of up to 64 bits");
+
+    // buckets are sorted in place through pointers
+    if constexpr (!is_contiguous_iterator<RandomIt>) {
+        sort_flat_copy(first, last, shader, window, [](auto copy_first, auto copy_last, auto* copy_shader, auto* copy_window) {
+            sample_sort(copy_first, copy_last, copy_shader, copy_window);
+        });
+        return;
+    }
+
+    constexpr int levels = 8;
+    constexpr int buckets = 1 << levels;
+    constexpr int oversampling = 16;
+
+    // buckets are sorted with the fastest sequential sort for the type, which also handles small inputs
+    auto sort_bucket = [](T* bucket_first, T* bucket_last) {
+        if constexpr (std::is_same<T, int32_t>::value) {simd_quicksort(bucket_first, bucket_last, nullptr, nullptr);}
+        else {radix_sort(bucket_first, bucket_last, nullptr, nullptr);}
+    };
+
+    const std::size_t n = last - first;
+    if (n < 2) {return;}
+
+    if (n < (1u << 16)) {
+        sort_bucket(&*first, &*first + n);
+        draw_array(first, last, shader, window);
+        return;
+    }
+
+    // sorted random sample, every oversampling'th element is a splitter
+    std::vector<T> sample(buckets * oversampling);
+    std::mt19937_64 rng{n};
+    for (auto& value : sample) {value = *(first + rng() % n);}
+    sort_bucket(sample.data(), sample.data() + sample.size());
+
+    // bucket b holds the elements above splitter b - 1 and up to splitter b. a repeated splitter would leave empty buckets
+    // between its copies and one bucket holding every copy of its value, so repeats are dropped and the last one is
+    // padded out to fill the tree, and each splitter's value goes in an equality bucket of its own. the last bucket
+    // has no splitter above it, its copy of the largest one is below everything in it
+    T splitters[buckets];
+    for (int b = 0; b < buckets - 1; ++b) {splitters[b] = sample[(b + 1) * oversampling - 1];}
+    const auto unique_end = std::unique(splitters, splitters + buckets - 1);
+    const bool equality_buckets = unique_end != splitters + buckets - 1;
+    std::fill(unique_end, splitters + buckets, *(unique_end - 1));
+
+    // splitters as an implicit binary tree, node i has children 2i and 2i + 1, so a lookup is one index calculation a level
+    T tree[buckets];
+    std::size_t next_splitter = 0;
+    auto fill_tree = [&](const auto& fill, std::size_t node) -> void {
+        if (node >= buckets) {return;}
+        fill(fill, 2 * node);
+        tree[node] = splitters[next_splitter++];
+        fill(fill, 2 * node + 1);
+    };
+    fill_tree(fill_tree, 1);
+
+    // bucket b is split into 2b for the elements below its splitter and 2b + 1 for the ones equal to it
+    constexpr int classes = 2 * buckets;
+
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    auto slice_first = [n, threads](unsigned t) {return n * t / threads;};
+
+    std::vector<uint16_t> bucket_of(n);
+    std::vector<std::size_t> counts(threads * classes, 0);   // counts[t * classes + class] for thread t's slice
+
+    run_threads(threads, [&](unsigned t) {
+        std::size_t* count = &counts[t * classes];
+        for (std::size_t i = slice_first(t); i < slice_first(t + 1); ++i) {
+            const T value = *(first + i);
+
+            // go right when the splitter is smaller, the comparison result is the next step so there is nothing to predict
+            std::size_t node = 1;
+            for (int level = 0; level < levels; ++level) {
+                node = 2 * node + (tree[node] < value);
+            }
+
+            const std::size_t bucket = node - buckets;
+            const std::size_t element_class = 2 * bucket + (equality_buckets & (value == splitters[bucket]));
+            bucket_of[i] = static_cast<uint16_t>(element_class);
+            ++count[element_class];
+        }
+    });
+
+    // where each class starts in the sorted array
+    std::size_t bucket_first[classes + 1];
+    bucket_first[0] = 0;
+    for (int c = 0; c < classes; ++c) {
+        std::size_t total = 0;
+        for (unsigned t = 0; t < threads; ++t) {total += counts[t * classes + c];}
+        bucket_first[c + 1] = bucket_first[c] + total;
+    }
+
+    std::unique_ptr<T[]> buffer(new T[n]);
+    run_threads(threads, [&](unsigned t) {
+        // this thread's part of each bucket comes after the earlier threads' parts
+        std::size_t offsets[classes];
+        for (int c = 0; c < classes; ++c) {
+            offsets[c] = bucket_first[c];
+            for (unsigned other = 0; other < t; ++other) {offsets[c] += counts[other * classes + c];}
+        }
+
+        for (std::size_t i = slice_first(t); i < slice_first(t + 1); ++i) {
+            buffer[offsets[bucket_of[i]]++] = *(first + i);
+        }
+    });
+    draw_array(buffer.get(), buffer.get() + n, shader, window);
+
+    // buckets vary in size, so threads grab the next unsorted one instead of getting a fixed share. equality buckets
+    // are already sorted
+    std::atomic<int> next_bucket{0};
+    run_threads(threads, [&](unsigned) {
+        for (int b = next_bucket++; b < buckets; b = next_bucket++) {
+            sort_bucket(buffer.get() + bucket_first[2 * b], buffer.get() + bucket_first[2 * b + 1]);
+        }
+    });
+
+    run_threads(threads, [&](unsigned t) {
+        std::copy(buffer.get() + slice_first(t), buffer.get() + slice_first(t + 1), first + slice_first(t));
+    });
+    draw_array(first, last, shader, window);
+}
+
+
+// stable merge of [first, middle) and [middle, last) through buffer, uninitialized room for buffer_size elements
+template <class RandomIt, class T>
+void inplace_merge(RandomIt first, RandomIt middle, RandomIt last, T* buffer, std::ptrdiff_t buffer_size,
+                   const Shader* shader, GLFWwindow* window, RandomIt OG_first, RandomIt OG_last) {
+    if (first == middle || middle == last) {return;}
+
+    // already in order, nothing to merge
+    if (!(*middle < *(middle - 1))) {return;}
+
+    const auto left_size = middle - first;
+    const auto right_size = last - middle;
+
+    if (left_size <= buffer_size || right_size <= buffer_size) {
+        if (left_size <= right_size) {
+            // move the left run out and merge forwards into the gap, taking from the left on ties
+            std::uninitialized_move(first, middle, buffer);
+            T* left = buffer;
+            T* left_end = buffer + left_size;
+            auto right = middle;
+            auto out = first;
+
+            while (left != left_end && right != last) {
+                *out++ = (*right < *left) ? std::move(*right++) : std::move(*left++);
+                draw_array(OG_first, OG_last, shader, window);
+            }
+            std::move(left, left_end, out);
+            std::destroy(buffer, buffer + left_size);
+        }
+        else {
+            // move the right run out and merge backwards, taking from the right on ties
+            std::uninitialized_move(middle, last, buffer);
+            T* right_end = buffer + right_size;
+            auto left_end = middle;
+            auto out = last;
+
+            while (left_end != first && right_end != buffer) {
+                *--out = (*(right_end - 1) < *(left_end - 1)) ? std::move(*--left_end) : std::move(*--right_end);
+                draw_array(OG_first, OG_last, shader, window);
+            }
+            std::move_backward(buffer, right_end, out);
+            std::destroy(buffer, buffer + right_size);
+        }
+        draw_array(OG_first, OG_last, shader, window);
+        return;
+    }
+
+    // cut the longer run in half and find where that value belongs in the other run. lower bound on the right and
+    // upper bound on the left keep equal values in their original order
+    RandomIt left_cut, right_cut;
+    if (left_size > right_size) {
+        left_cut = first + left_size / 2;
+        right_cut = std::lower_bound(middle, last, *left_cut);
+    }
+    else {
+        right_cut = middle + right_size / 2;
+        left_cut = std::upper_bound(first, middle, *right_cut);
+    }
+
+    // swap the blocks between the cuts so everything before the new middle belongs before everything after it
+    std::rotate(left_cut, middle, right_cut);
+    draw_array(OG_first, OG_last, shader, window);
+    const RandomIt new_middle = left_cut + (right_cut - middle);
+
+    inplace_merge(first, left_cut, new_middle, buffer, buffer_size, shader, window, OG_first, OG_last);
+    inplace_merge(new_middle, right_cut, last, buffer, buffer_size, shader, window, OG_first, OG_last);
+}
+
+template <class RandomIt>
+void inplace_merge_sort(RandomIt first, RandomIt last, const Shader* shader, GLFWwindow* window) {
+    using T = typename std::iterator_traits<RandomIt>::value_type;
+    constexpr std::ptrdiff_t block = 32;
+    constexpr std::ptrdiff_t buffer_size = 512;
+    const auto n = last - first;
+
+    // room for the merge buffer without constructing anything in it, or needing T to be default constructible
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage[buffer_size];
+    T* const buffer = reinterpret_cast<T*>(storage);
+
+    for (std::ptrdiff_t i = 0; i < n; i += block) {
+        network_sort(first + i, first + std::min(i + block, n), shader, nullptr);
+    }
+    draw_array(first, last, shader, window);
+
+    for (std::ptrdiff_t width = block; width < n; width *= 2) {
+        for (std::ptrdiff_t i = 0; i + width < n; i += 2 * width) {
+            inplace_merge(first + i, first + i + width, first + std::min(i + 2 * width, n), buffer, buffer_size,
+                          shader, window, first, last);
+        }
+    }
 }
 
 